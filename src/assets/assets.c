@@ -60,6 +60,49 @@ void assets_init(int force_reload, color_t **main_images, int *main_image_widths
     data.asset_lookup[ASSET_UI_RISKS] = assets_get_image_id("UI", "Risk_Widget_Collapse");
     data.asset_lookup[ASSET_UI_SELECTION_CHECKMARK] = assets_get_image_id("UI", "Selection_Checkmark");
     data.asset_lookup[ASSET_UI_VERTICAL_EMPIRE_PANEL] = assets_get_image_id("UI", "Empire_panel_texture_vertical");
+    // Figure sprites are looked up every tick, so their names are only resolved once
+    data.asset_lookup[ASSET_FIGURE_ARCHITECT] = assets_get_image_id("Walkers", "architect_ne_01");
+    data.asset_lookup[ASSET_FIGURE_ARCHITECT_DEATH] = assets_get_image_id("Walkers", "architect_death_01");
+    data.asset_lookup[ASSET_FIGURE_ARCHITECT_WORKING] = assets_get_image_id("Walkers", "Architect 01");
+    data.asset_lookup[ASSET_FIGURE_BARKEEP] = assets_get_image_id("Walkers", "Barkeep NE 01");
+    data.asset_lookup[ASSET_FIGURE_BARKEEP_DEATH] = assets_get_image_id("Walkers", "Barkeep Death 01");
+    data.asset_lookup[ASSET_FIGURE_BARRACKS_WORKER] = assets_get_image_id("Walkers", "barracks_worker_ne_01");
+    data.asset_lookup[ASSET_FIGURE_BARRACKS_WORKER_DEATH] = assets_get_image_id("Walkers", "barracks_worker_death_01");
+    data.asset_lookup[ASSET_FIGURE_CARAVANSERAI_OVERSEER] =
+        assets_get_image_id("Walkers", "caravanserai_overseer_ne_01");
+    data.asset_lookup[ASSET_FIGURE_CARAVANSERAI_OVERSEER_DEATH] =
+        assets_get_image_id("Walkers", "caravanserai_overseer_death_01");
+    data.asset_lookup[ASSET_FIGURE_CARAVANSERAI_WALKER] = assets_get_image_id("Walkers", "caravanserai_walker_ne_01");
+    data.asset_lookup[ASSET_FIGURE_CARAVANSERAI_WALKER_DEATH] =
+        assets_get_image_id("Walkers", "caravanserai_walker_death_01");
+    data.asset_lookup[ASSET_FIGURE_MARKET_BUYER] = assets_get_image_id("Walkers", "marketbuyer_ne_01");
+    data.asset_lookup[ASSET_FIGURE_MARKET_BUYER_DEATH] = assets_get_image_id("Walkers", "marketbuyer_death_01");
+    data.asset_lookup[ASSET_FIGURE_MESS_HALL_BUYER] = assets_get_image_id("Walkers", "M Hall NE 01");
+    data.asset_lookup[ASSET_FIGURE_MESS_HALL_BUYER_DEATH] = assets_get_image_id("Walkers", "M Hall death 01");
+    data.asset_lookup[ASSET_FIGURE_OVERSEER] = assets_get_image_id("Walkers", "overseer_ne_01");
+    data.asset_lookup[ASSET_FIGURE_OVERSEER_DEATH] = assets_get_image_id("Walkers", "overseer_death_01");
+    data.asset_lookup[ASSET_FIGURE_QUARTERMASTER] = assets_get_image_id("Walkers", "quartermaster_ne_01");
+    data.asset_lookup[ASSET_FIGURE_QUARTERMASTER_DEATH] = assets_get_image_id("Walkers", "quartermaster_death_01");
+    data.asset_lookup[ASSET_FIGURE_QUARTERMASTER_FIGHT] = assets_get_image_id("Walkers", "quartermaster_f_ne_01");
+    data.asset_lookup[ASSET_FIGURE_SLAVE] = assets_get_image_id("Walkers", "Slave NE 01");
+    data.asset_lookup[ASSET_FIGURE_SLAVE_DEATH] = assets_get_image_id("Walkers", "Slave death 01");
+    data.asset_lookup[ASSET_FIGURE_DOCTOR_HEAL] = assets_get_image_id("Health_Culture", "Doctor heal");
+    data.asset_lookup[ASSET_FIGURE_AUXARCH] = assets_get_image_id("Warriors", "auxarch_ne_01");
+    data.asset_lookup[ASSET_FIGURE_AUXARCH_DEATH] = assets_get_image_id("Warriors", "auxarch_death_01");
+    data.asset_lookup[ASSET_FIGURE_AUXARCH_FIGHT] = assets_get_image_id("Warriors", "auxarch_fm_ne_01");
+    data.asset_lookup[ASSET_FIGURE_AUXARCH_FIRE] = assets_get_image_id("Warriors", "auxarch_fr_ne_01");
+    data.asset_lookup[ASSET_FIGURE_AUXARCH_BANNER] = assets_get_image_id("UI", "auxarch_banner_0");
+    data.asset_lookup[ASSET_FIGURE_AUXARCH_BANNER_ANIMATION] = assets_get_image_id("UI", "auxarch_banner_01");
+    data.asset_lookup[ASSET_FIGURE_AUXINF] = assets_get_image_id("Warriors", "auxinf_ne_01");
+    data.asset_lookup[ASSET_FIGURE_AUXINF_DEATH] = assets_get_image_id("Warriors", "auxinf_death_01");
+    data.asset_lookup[ASSET_FIGURE_AUXINF_FIGHT] = assets_get_image_id("Warriors", "auxinf_f_ne_01");
+    data.asset_lookup[ASSET_FIGURE_AUXINF_BANNER] = assets_get_image_id("UI", "auxinf_banner_0");
+    data.asset_lookup[ASSET_FIGURE_AUXINF_BANNER_ANIMATION] = assets_get_image_id("UI", "auxinf_banner_01");
+    data.asset_lookup[ASSET_FIGURE_CATAPULT] = assets_get_image_id("Warriors", "catapult_ne_01");
+    data.asset_lookup[ASSET_FIGURE_CATAPULT_DEATH] = assets_get_image_id("Warriors", "catapult_death_01");
+    data.asset_lookup[ASSET_FIGURE_CATAPULT_FIRE] = assets_get_image_id("Warriors", "catapult_fe_e_01");
+    data.asset_lookup[ASSET_FIGURE_CATAPULT_ROCK] = assets_get_image_id("Warriors", "catapult_rock_ne_01");
+    data.asset_lookup[ASSET_FIGURE_LEGIONARY_FIRE] = assets_get_image_id("Warriors", "legionary_fr_ne_01");
 }
 
 int assets_load_single_group(const char *file_name, color_t **main_images, int *main_image_widths)
@@ -22,6 +22,45 @@ typedef enum {
 	ASSET_UI_RISKS,
 	ASSET_UI_SELECTION_CHECKMARK,
 	ASSET_UI_VERTICAL_EMPIRE_PANEL,
+	ASSET_FIGURE_ARCHITECT,
+	ASSET_FIGURE_ARCHITECT_DEATH,
+	ASSET_FIGURE_ARCHITECT_WORKING,
+	ASSET_FIGURE_BARKEEP,
+	ASSET_FIGURE_BARKEEP_DEATH,
+	ASSET_FIGURE_BARRACKS_WORKER,
+	ASSET_FIGURE_BARRACKS_WORKER_DEATH,
+	ASSET_FIGURE_CARAVANSERAI_OVERSEER,
+	ASSET_FIGURE_CARAVANSERAI_OVERSEER_DEATH,
+	ASSET_FIGURE_CARAVANSERAI_WALKER,
+	ASSET_FIGURE_CARAVANSERAI_WALKER_DEATH,
+	ASSET_FIGURE_MARKET_BUYER,
+	ASSET_FIGURE_MARKET_BUYER_DEATH,
+	ASSET_FIGURE_MESS_HALL_BUYER,
+	ASSET_FIGURE_MESS_HALL_BUYER_DEATH,
+	ASSET_FIGURE_OVERSEER,
+	ASSET_FIGURE_OVERSEER_DEATH,
+	ASSET_FIGURE_QUARTERMASTER,
+	ASSET_FIGURE_QUARTERMASTER_DEATH,
+	ASSET_FIGURE_QUARTERMASTER_FIGHT,
+	ASSET_FIGURE_SLAVE,
+	ASSET_FIGURE_SLAVE_DEATH,
+	ASSET_FIGURE_DOCTOR_HEAL,
+	ASSET_FIGURE_AUXARCH,
+	ASSET_FIGURE_AUXARCH_DEATH,
+	ASSET_FIGURE_AUXARCH_FIGHT,
+	ASSET_FIGURE_AUXARCH_FIRE,
+	ASSET_FIGURE_AUXARCH_BANNER,
+	ASSET_FIGURE_AUXARCH_BANNER_ANIMATION,
+	ASSET_FIGURE_AUXINF,
+	ASSET_FIGURE_AUXINF_DEATH,
+	ASSET_FIGURE_AUXINF_FIGHT,
+	ASSET_FIGURE_AUXINF_BANNER,
+	ASSET_FIGURE_AUXINF_BANNER_ANIMATION,
+	ASSET_FIGURE_CATAPULT,
+	ASSET_FIGURE_CATAPULT_DEATH,
+	ASSET_FIGURE_CATAPULT_FIRE,
+	ASSET_FIGURE_CATAPULT_ROCK,
+	ASSET_FIGURE_LEGIONARY_FIRE,
 	ASSET_MAX_KEY
 } asset_id;
 
@@ -7,6 +7,7 @@
 #include "building/model.h"
 #include "building/monument.h"
 #include "building/properties.h"
+#include "building/roadblock.h"
 #include "building/rotation.h"
 #include "building/state.h"
 #include "building/storage.h"
@@ -21,6 +22,7 @@
 #include "core/log.h"
 #include "figure/figure.h"
 #include "figure/formation_legion.h"
+#include "figure/roamer_preview.h"
 #include "game/difficulty.h"
 #include "game/save_version.h"
 #include "game/undo.h"
@@ -45,6 +47,8 @@ static struct {
     array(building) buildings;
     building *first_of_type[BUILDING_TYPE_MAX];
     building *last_of_type[BUILDING_TYPE_MAX];
+    int type_lists_revision;
+    int houses_revision;
 } data;
 
 static struct {
@@ -101,6 +105,16 @@ building *building_first_of_type(building_type type)
     return data.first_of_type[type];
 }
 
+int building_type_lists_revision(void)
+{
+    return data.type_lists_revision;
+}
+
+int building_houses_revision(void)
+{
+    return data.houses_revision;
+}
+
 building *building_main(building *b)
 {
     for (int guard = 0; guard < 9; guard++) {
@@ -117,8 +131,21 @@ building *building_next(building *b)
     return array_item(data.buildings, b->next_part_building_id);
 }
 
+static void invalidate_roamer_previews(const building *b)
+{
+    // roamers stop at roadblocks, so walks cached before one was added or removed no longer apply
+    if (building_type_is_roadblock(b->type)) {
+        figure_roamer_preview_clear_cache();
+    }
+}
+
 static void fill_adjacent_types(building *b)
 {
+    invalidate_roamer_previews(b);
+    data.type_lists_revision++;
+    if (building_is_house(b->type)) {
+        data.houses_revision++;
+    }
     building *first = data.first_of_type[b->type];
     building *last = data.last_of_type[b->type];
     if (!first || !last) {
@@ -155,6 +182,11 @@ static void fill_adjacent_types(building *b)
 
 static void remove_adjacent_types(building *b)
 {
+    invalidate_roamer_previews(b);
+    data.type_lists_revision++;
+    if (building_is_house(b->type)) {
+        data.houses_revision++;
+    }
     building *first = data.first_of_type[b->type];
     building *last = data.last_of_type[b->type];
     if (b == first && b == last) {
@@ -272,6 +304,9 @@ static void building_delete(building *b)
 {
     building_clear_related_data(b);
     remove_adjacent_types(b);
+    if (b->type == BUILDING_WAREHOUSE || b->type == BUILDING_WAREHOUSE_SPACE || b->type == BUILDING_GRANARY) {
+        building_storage_stock_changed();
+    }
     int id = b->id;
     memset(b, 0, sizeof(building));
     b->id = id;
@@ -614,6 +649,8 @@ void building_clear_all(void)
 {
     memset(data.first_of_type, 0, sizeof(data.first_of_type));
     memset(data.last_of_type, 0, sizeof(data.last_of_type));
+    data.type_lists_revision++;
+    data.houses_revision++;
 
     if (!array_init(data.buildings, BUILDING_ARRAY_SIZE_STEP, initialize_new_building, building_in_use) ||
         !array_next(data.buildings)) { // Ignore first building
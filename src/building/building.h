@@ -215,6 +215,18 @@ int building_find(building_type type);
 
 building *building_first_of_type(building_type type);
 
+/**
+ * Gets a counter that changes whenever a building is added to or removed from the per-type lists
+ * @return Type lists revision
+ */
+int building_type_lists_revision(void);
+
+/**
+ * Gets a counter that changes whenever a house is added, removed or changes type
+ * @return Houses revision
+ */
+int building_houses_revision(void);
+
 void building_change_type(building *b, building_type type);
 
 building *building_main(building *b);
@@ -12,11 +12,14 @@
 #include "core/config.h"
 #include "empire/trade_prices.h"
 #include "figure/figure.h"
+#include "game/time.h"
 #include "map/road_access.h"
 #include "map/routing_terrain.h"
 #include "scenario/property.h"
 #include "sound/effect.h"
 
+#include <string.h>
+
 #define MAX_GRANARIES 100
 #define CURSE_LOADS BUILDING_STORAGE_QUANTITY_MAX / 2
 #define INFINITE 10000
@@ -29,6 +32,17 @@ static struct {
     int total_storage[RESOURCE_MAX_FOOD];
 } non_getting_granaries;
 
+// Amount of each food stored in granaries in use, in total and excluding the granaries
+// maintaining it, recalculated in a single pass once stored goods or settings have changed
+static struct {
+    int is_valid;
+    int revision;
+    int tick;
+    int total_days;
+    int total[RESOURCE_MAX];
+    int not_maintaining[RESOURCE_MAX];
+} stock_index;
+
 static int get_amount(building *granary, int resource)
 {
     if (!resource_is_food(resource)) {
@@ -281,16 +295,42 @@ int building_granary_count_available_resource(building *b, int resource, int res
     }
 }
 
-int building_granaries_count_available_resource(int resource, int respect_maintaining)
+static void update_stock_index(void)
 {
-    int total = 0;
-
+    int revision = building_storage_stock_revision();
+    int tick = game_time_tick();
+    int total_days = game_time_total_months() * 16 + game_time_day();
+    if (stock_index.is_valid && stock_index.revision == revision &&
+        stock_index.tick == tick && stock_index.total_days == total_days) {
+        return;
+    }
+    memset(stock_index.total, 0, sizeof(stock_index.total));
+    memset(stock_index.not_maintaining, 0, sizeof(stock_index.not_maintaining));
     for (building *b = building_first_of_type(BUILDING_GRANARY); b; b = b->next_of_type) {
-
-        total += building_granary_count_available_resource(b, resource, respect_maintaining);
+        if (b->state != BUILDING_STATE_IN_USE) {
+            continue;
+        }
+        for (resource_type r = RESOURCE_NONE; r < RESOURCE_MAX; r++) {
+            int amount = building_granary_resource_amount(r, b);
+            stock_index.total[r] += amount;
+            if (!building_granary_is_maintaining(r, b)) {
+                stock_index.not_maintaining[r] += amount;
+            }
+        }
     }
+    stock_index.is_valid = 1;
+    stock_index.revision = revision;
+    stock_index.tick = tick;
+    stock_index.total_days = total_days;
+}
 
-    return total;
+int building_granaries_count_available_resource(int resource, int respect_maintaining)
+{
+    if (resource < RESOURCE_NONE || resource >= RESOURCE_MAX) {
+        return 0;
+    }
+    update_stock_index();
+    return respect_maintaining ? stock_index.not_maintaining[resource] : stock_index.total[resource];
 }
 
 int building_granaries_send_resources_to_rome(int resource, int amount)
@@ -698,6 +738,7 @@ void building_granary_update_built_granaries_capacity(void)
 
         if (total_units < BUILDING_STORAGE_QUANTITY_MAX) {
             b->resources[RESOURCE_NONE] += BUILDING_STORAGE_QUANTITY_MAX - total_units;
+            building_storage_stock_changed();
         }
         // for now, we don't handle the case where we decrease granary capacity
     }
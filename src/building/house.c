@@ -2,6 +2,7 @@
 
 #include "building/image.h"
 #include "city/population.h"
+#include "core/array.h"
 #include "core/config.h"
 #include "core/image.h"
 #include "figure/figure.h"
@@ -16,6 +17,7 @@
 #include "map/terrain.h"
 
 #define MAX_DIR 4
+#define HOUSE_LIST_SIZE_STEP 500
 
 #define OFFSET(x,y) (x + GRID_SIZE * y)
 
@@ -39,6 +41,15 @@ static struct {
     int population;
 } merge_data;
 
+// All house buildings, so the city-wide house passes walk one packed list instead of
+// the list of every house type. Buildings never move in memory until they are all cleared,
+// which also changes the houses revision, so the list can hold them directly.
+static struct {
+    array(building *) houses;
+    int revision;
+    int is_valid;
+} house_list;
+
 void building_house_change_to(building *house, building_type type)
 {
     building_change_type(house, type);
@@ -611,3 +622,36 @@ void building_house_restore_population_after_undo(building *house)
         }
     }
 }
+
+static void rebuild_house_list(void)
+{
+    if (!house_list.houses.blocks && !array_init(house_list.houses, HOUSE_LIST_SIZE_STEP, 0, 0)) {
+        return;
+    }
+    house_list.houses.size = 0;
+    house_list.is_valid = 1;
+    house_list.revision = building_houses_revision();
+    for (building_type type = BUILDING_HOUSE_SMALL_TENT; type <= BUILDING_HOUSE_LUXURY_PALACE; type++) {
+        for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
+            building **house = array_advance(house_list.houses);
+            if (!house) {
+                house_list.is_valid = 0;
+                return;
+            }
+            *house = b;
+        }
+    }
+}
+
+int building_house_list_size(void)
+{
+    if (!house_list.is_valid || house_list.revision != building_houses_revision()) {
+        rebuild_house_list();
+    }
+    return house_list.houses.size;
+}
+
+building *building_house_list_item(int index)
+{
+    return *array_item(house_list.houses, index);
+}
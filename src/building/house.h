@@ -24,4 +24,18 @@ void building_house_check_for_corruption(building *house);
 
 void building_house_restore_population_after_undo(building *house);
 
+/**
+ * Gets the number of houses in the packed house list, rebuilding the list if houses were
+ * created, removed or changed type. The list also holds houses that are not in use.
+ * @return Number of houses in the list
+ */
+int building_house_list_size(void);
+
+/**
+ * Gets a house from the packed house list
+ * @param index Index in the list, below building_house_list_size()
+ * @return The house
+ */
+building *building_house_list_item(int index);
+
 #endif // BUILDING_HOUSE_H
@@ -1,6 +1,7 @@
 #include "house_service.h"
 
 #include "building/building.h"
+#include "building/house.h"
 #include "building/monument.h"
 #include "city/culture.h"
 
@@ -81,101 +82,101 @@ void house_service_calculate_culture_aggregates(void)
     int completed_colosseum = building_monument_working(BUILDING_COLOSSEUM);
     int completed_hippodrome = building_monument_working(BUILDING_HIPPODROME);
 
-    for (building_type type = BUILDING_HOUSE_SMALL_TENT; type <= BUILDING_HOUSE_LUXURY_PALACE; type++) {
-        for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
-            if (b->state != BUILDING_STATE_IN_USE || !b->house_size) {
-                continue;
-            }
-            int arena_total = 0;
-            int colosseum_total = 0;
+    int total_houses = building_house_list_size();
+    for (int i = 0; i < total_houses; i++) {
+        building *b = building_house_list_item(i);
+        if (b->state != BUILDING_STATE_IN_USE || !b->house_size) {
+            continue;
+        }
+        int arena_total = 0;
+        int colosseum_total = 0;
 
-            // Entertainment
-            b->data.house.entertainment = 0;
+        // Entertainment
+        b->data.house.entertainment = 0;
 
-            if (b->data.house.theater) {
-                b->data.house.entertainment += 10;
-            }
+        if (b->data.house.theater) {
+            b->data.house.entertainment += 10;
+        }
 
-            if (b->house_tavern_wine_access) {
-                b->data.house.entertainment += 10;
-                if (b->house_tavern_food_access) {
-                    b->data.house.entertainment += 5;
-                }
+        if (b->house_tavern_wine_access) {
+            b->data.house.entertainment += 10;
+            if (b->house_tavern_food_access) {
+                b->data.house.entertainment += 5;
             }
+        }
 
-            if (b->data.house.amphitheater_actor) {
-                if (b->data.house.amphitheater_gladiator) {
-                    b->data.house.entertainment += 15;
-                } else {
-                    b->data.house.entertainment += 10;
-                }
+        if (b->data.house.amphitheater_actor) {
+            if (b->data.house.amphitheater_gladiator) {
+                b->data.house.entertainment += 15;
+            } else {
+                b->data.house.entertainment += 10;
             }
+        }
 
-            if (b->house_arena_gladiator) {
-                arena_total = b->house_arena_lion ? 20 : 10;
-            }
+        if (b->house_arena_gladiator) {
+            arena_total = b->house_arena_lion ? 20 : 10;
+        }
 
-            if (b->data.house.colosseum_gladiator) {
-                colosseum_total = b->data.house.colosseum_lion ? 25 : 15;
-            }
+        if (b->data.house.colosseum_gladiator) {
+            colosseum_total = b->data.house.colosseum_lion ? 25 : 15;
+        }
 
-            b->data.house.entertainment += arena_total > colosseum_total ? arena_total : colosseum_total;
+        b->data.house.entertainment += arena_total > colosseum_total ? arena_total : colosseum_total;
 
-            if (b->data.house.hippodrome) {
-                b->data.house.entertainment += 30;
-            }
+        if (b->data.house.hippodrome) {
+            b->data.house.entertainment += 30;
+        }
 
-            if (completed_hippodrome) {
-                b->data.house.entertainment += 5;
-            }
+        if (completed_hippodrome) {
+            b->data.house.entertainment += 5;
+        }
 
-            if (completed_colosseum) {
-                b->data.house.entertainment += 5;
-            }
+        if (completed_colosseum) {
+            b->data.house.entertainment += 5;
+        }
 
-            // Venus Module 2 Entertainment Bonus
-            if (venus_module2 && b->data.house.temple_venus) {
-                b->data.house.entertainment += 10;
-            }
+        // Venus Module 2 Entertainment Bonus
+        if (venus_module2 && b->data.house.temple_venus) {
+            b->data.house.entertainment += 10;
+        }
 
-            // Education
-            b->data.house.education = 0;
-            if (b->data.house.school || b->data.house.library) {
-                b->data.house.education = 1;
-                if (b->data.house.school && b->data.house.library) {
-                    b->data.house.education = 2;
-                    if (b->data.house.academy) {
-                        b->data.house.education = 3;
-                    }
+        // Education
+        b->data.house.education = 0;
+        if (b->data.house.school || b->data.house.library) {
+            b->data.house.education = 1;
+            if (b->data.house.school && b->data.house.library) {
+                b->data.house.education = 2;
+                if (b->data.house.academy) {
+                    b->data.house.education = 3;
                 }
             }
+        }
 
-            // religion
-            b->data.house.num_gods = 0;
-            if (b->data.house.temple_ceres) {
-                ++b->data.house.num_gods;
-            }
-            if (b->data.house.temple_neptune) {
-                ++b->data.house.num_gods;
-            }
-            if (b->data.house.temple_mercury) {
-                ++b->data.house.num_gods;
-            }
-            if (b->data.house.temple_mars) {
-                ++b->data.house.num_gods;
-            }
-            if (b->data.house.temple_venus) {
-                ++b->data.house.num_gods;
-            }
+        // religion
+        b->data.house.num_gods = 0;
+        if (b->data.house.temple_ceres) {
+            ++b->data.house.num_gods;
+        }
+        if (b->data.house.temple_neptune) {
+            ++b->data.house.num_gods;
+        }
+        if (b->data.house.temple_mercury) {
+            ++b->data.house.num_gods;
+        }
+        if (b->data.house.temple_mars) {
+            ++b->data.house.num_gods;
+        }
+        if (b->data.house.temple_venus) {
+            ++b->data.house.num_gods;
+        }
 
-            // health
-            b->data.house.health = 0;
-            if (b->data.house.clinic) {
-                ++b->data.house.health;
-            }
-            if (b->data.house.hospital) {
-                ++b->data.house.health;
-            }
+        // health
+        b->data.house.health = 0;
+        if (b->data.house.clinic) {
+            ++b->data.house.health;
+        }
+        if (b->data.house.hospital) {
+            ++b->data.house.health;
         }
     }
 }
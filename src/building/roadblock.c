@@ -2,12 +2,14 @@
 
 #include "building/building.h"
 #include "building/type.h"
+#include "figure/roamer_preview.h"
 
 void building_roadblock_set_permission(roadblock_permission p, building *b)
 {
     if (building_type_is_roadblock(b->type)) {
         int permission_bit = 1 << p;
         b->data.roadblock.exceptions ^= permission_bit;
+        figure_roamer_preview_clear_cache();
     }
 }
 
@@ -44,6 +46,7 @@ void building_roadblock_accept_none(building *b)
 {
     if (building_type_is_roadblock(b->type)) {
         b->data.roadblock.exceptions = 0;
+        figure_roamer_preview_clear_cache();
     }
 }
 
@@ -51,5 +54,6 @@ void building_roadblock_accept_all(building *b)
 {
     if (building_type_is_roadblock(b->type)) {
         b->data.roadblock.exceptions = ROADBLOCK_PERMISSION_ALL;
+        figure_roamer_preview_clear_cache();
     }
 }
@@ -16,6 +16,17 @@
 #define STORAGE_CURRENT_BUFFER_SIZE (STORAGE_STATIC_BUFFER_SIZE + RESOURCE_MAX * 2)
 
 static array(data_storage) storages;
+static int stock_revision;
+
+void building_storage_stock_changed(void)
+{
+    stock_revision++;
+}
+
+int building_storage_stock_revision(void)
+{
+    return stock_revision;
+}
 
 static void storage_create(data_storage *storage, unsigned int position)
 {
@@ -29,6 +40,7 @@ static int storage_in_use(const data_storage *storage)
 
 void building_storage_clear_all(void)
 {
+    stock_revision++;
     if (!array_init(storages, STORAGE_ARRAY_SIZE_STEP, storage_create, storage_in_use) ||
         !array_next(storages)) { // Ignore first storage
         log_error("Unable to create storages. The game will likely crash.", 0, 0);
@@ -100,6 +112,7 @@ int building_storage_get_building_id(int storage_id)
 
 int building_storage_restore(int storage_id)
 {
+    stock_revision++;
     if (array_item(storages, storage_id)->in_use) {
         return 0;
     }
@@ -112,6 +125,7 @@ int building_storage_restore(int storage_id)
 
 void building_storage_delete(int storage_id)
 {
+    stock_revision++;
     array_item(storages, storage_id)->in_use = 0;
     array_trim(storages);
 }
@@ -128,6 +142,7 @@ const data_storage *building_storage_get_array_entry(int storage_id)
 
 void building_storage_set_data(int storage_id, building_storage new_data)
 {
+    stock_revision++;
     array_item(storages, storage_id)->storage = new_data;
 }
 
@@ -138,6 +153,7 @@ void building_storage_toggle_empty_all(int storage_id)
 
 void building_storage_cycle_resource_state(int storage_id, resource_type resource_id)
 {
+    stock_revision++;
     resource_storage_entry *entry = &array_item(storages, storage_id)->storage.resource_state[resource_id];
 
     switch (entry->state) {
@@ -174,6 +190,7 @@ int building_storage_get_permission(building_storage_permission_states p, buildi
 
 void building_storage_cycle_partial_resource_state(int storage_id, resource_type resource_id, int reverse_order)
 {
+    stock_revision++;
     resource_storage_entry *entry = &array_item(storages, storage_id)->storage.resource_state[resource_id];
 
     if (entry->state == BUILDING_STORAGE_STATE_NOT_ACCEPTING) {
@@ -209,6 +226,7 @@ void building_storage_cycle_partial_resource_state(int storage_id, resource_type
 
 void building_storage_accept_none(int storage_id)
 {
+    stock_revision++;
     data_storage *s = array_item(storages, storage_id);
     for (int r = RESOURCE_MIN; r < RESOURCE_MAX; r++) {
         s->storage.resource_state[r].state = BUILDING_STORAGE_STATE_NOT_ACCEPTING;
@@ -218,6 +236,7 @@ void building_storage_accept_none(int storage_id)
 
 void building_storage_accept_all(int storage_id)
 {
+    stock_revision++;
     data_storage *s = array_item(storages, storage_id);
     for (int r = RESOURCE_MIN; r < RESOURCE_MAX; r++) {
         s->storage.resource_state[r].state = BUILDING_STORAGE_STATE_ACCEPTING;
@@ -303,6 +322,7 @@ void building_storage_save_state(buffer *buf)
 
 void building_storage_load_state(buffer *buf, int version)
 {
+    stock_revision++;
     int storage_buf_size;
     size_t buf_size = buf->size;
     int storages_to_load;
@@ -74,6 +74,17 @@ typedef struct {
  */
 void building_storage_clear_all(void);
 
+/**
+ * Marks the goods stored in warehouses or granaries as changed
+ */
+void building_storage_stock_changed(void);
+
+/**
+ * Gets a counter that changes whenever stored goods or storage settings change
+ * @return Stock revision
+ */
+int building_storage_stock_revision(void);
+
 /**
  * Creates a building storage
  * @param building_id The id of the building this is a storage for
@@ -13,14 +13,28 @@
 #include "core/image.h"
 #include "empire/trade_prices.h"
 #include "figure/figure.h"
+#include "game/time.h"
 #include "game/tutorial.h"
 #include "map/image.h"
 #include "scenario/property.h"
 
+#include <string.h>
+
 #define INFINITE 10000
 
 #define MAX_CARTLOADS_PER_SPACE 4
 
+// Amount of each resource stored in warehouses in use, in total and excluding the warehouses
+// maintaining it, recalculated in a single pass once stored goods or settings have changed
+static struct {
+    int is_valid;
+    int revision;
+    int tick;
+    int total_days;
+    int total[RESOURCE_MAX];
+    int not_maintaining[RESOURCE_MAX];
+} stock_index;
+
 int building_warehouse_get_space_info(building *warehouse)
 {
     int total_loads = 0;
@@ -411,25 +425,57 @@ int building_warehouse_max_space_for_resource(resource_type resource, building *
     return max_storable;
 }
 
-int building_warehouses_count_available_resource(int resource, int respect_maintaining)
+static void add_warehouse_to_stock_index(building *warehouse)
 {
-    int total = 0;
-    building *b = get_next_warehouse();
-    if (!b) {
-        return 0;
+    int amounts[RESOURCE_MAX] = { 0 };
+    building *space = warehouse;
+    for (int i = 0; i < 8; i++) {
+        space = building_next(space);
+        if (space->id <= 0) {
+            return;
+        }
+        amounts[space->subtype.warehouse_resource_id] += space->resources[space->subtype.warehouse_resource_id];
     }
-    building *initial_warehouse = b;
+    for (resource_type r = RESOURCE_MIN; r < RESOURCE_MAX; r++) {
+        if (amounts[r] <= 0) {
+            continue;
+        }
+        stock_index.total[r] += amounts[r];
+        if (!building_warehouse_is_maintaining(r, warehouse)) {
+            stock_index.not_maintaining[r] += amounts[r];
+        }
+    }
+}
 
-    do {
+static void update_stock_index(void)
+{
+    int revision = building_storage_stock_revision();
+    int tick = game_time_tick();
+    int total_days = game_time_total_months() * 16 + game_time_day();
+    if (stock_index.is_valid && stock_index.revision == revision &&
+        stock_index.tick == tick && stock_index.total_days == total_days) {
+        return;
+    }
+    memset(stock_index.total, 0, sizeof(stock_index.total));
+    memset(stock_index.not_maintaining, 0, sizeof(stock_index.not_maintaining));
+    for (building *b = building_first_of_type(BUILDING_WAREHOUSE); b; b = b->next_of_type) {
         if (b->state == BUILDING_STATE_IN_USE) {
-            if (!respect_maintaining || !building_warehouse_is_maintaining(resource, b)) {
-                total += building_warehouse_get_amount(b, resource);
-            }
+            add_warehouse_to_stock_index(b);
         }
-        b = b->next_of_type ? b->next_of_type : building_first_of_type(BUILDING_WAREHOUSE);
-    } while (b != initial_warehouse);
+    }
+    stock_index.is_valid = 1;
+    stock_index.revision = revision;
+    stock_index.tick = tick;
+    stock_index.total_days = total_days;
+}
 
-    return total;
+int building_warehouses_count_available_resource(int resource, int respect_maintaining)
+{
+    if (resource < RESOURCE_MIN || resource >= RESOURCE_MAX) {
+        return 0;
+    }
+    update_stock_index();
+    return respect_maintaining ? stock_index.not_maintaining[resource] : stock_index.total[resource];
 }
 
 
@@ -2,6 +2,7 @@
 
 #include "building/building.h"
 #include "building/count.h"
+#include "building/house.h"
 #include "building/monument.h"
 #include "city/constants.h"
 #include "city/data_private.h"
@@ -238,18 +239,18 @@ void city_culture_calculate(void)
     city_data.culture.population_with_venus_access = 0; //venus
 
     int num_houses = 0;
-    for (building_type type = BUILDING_HOUSE_SMALL_TENT; type <= BUILDING_HOUSE_LUXURY_PALACE; type++) {
-        for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
-            if (b->state == BUILDING_STATE_IN_USE && b->house_size) {
-                num_houses++;
-                city_data.culture.average_entertainment += b->data.house.entertainment;
-                city_data.culture.average_religion += b->data.house.num_gods;
-                city_data.culture.average_education += b->data.house.education;
-                city_data.culture.average_health += b->data.house.health;
-                city_data.culture.average_desirability += b->desirability;
-                if (b->data.house.temple_venus) {
-                    city_data.culture.population_with_venus_access += b->house_population;
-                }
+    int total_houses = building_house_list_size();
+    for (int i = 0; i < total_houses; i++) {
+        building *b = building_house_list_item(i);
+        if (b->state == BUILDING_STATE_IN_USE && b->house_size) {
+            num_houses++;
+            city_data.culture.average_entertainment += b->data.house.entertainment;
+            city_data.culture.average_religion += b->data.house.num_gods;
+            city_data.culture.average_education += b->data.house.education;
+            city_data.culture.average_health += b->data.house.health;
+            city_data.culture.average_desirability += b->desirability;
+            if (b->data.house.temple_venus) {
+                city_data.culture.population_with_venus_access += b->house_population;
             }
         }
     }
@@ -359,21 +359,21 @@ void city_health_update(void)
     city_data.health.population_access.barber = 0;
     city_data.health.population_access.baths = 0;
 
-    for (building_type type = BUILDING_HOUSE_SMALL_TENT; type <= BUILDING_HOUSE_LUXURY_PALACE; type++) {
-        for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
-            if (b->state != BUILDING_STATE_IN_USE || !b->house_size) {
-                continue;
-            }
-            if (!b->house_population) {
-                b->sickness_level = 0;
-                continue;
-            }
-            int house_health = city_health_get_house_health_level(b, 1);
-
-            total_population += b->house_population;
-            healthy_population += calc_adjust_with_percentage(b->house_population, house_health);
-            adjust_sickness_level_in_house(b, house_health, population_health_offset, hospital_coverage_bonus);
+    int total_houses = building_house_list_size();
+    for (int i = 0; i < total_houses; i++) {
+        building *b = building_house_list_item(i);
+        if (b->state != BUILDING_STATE_IN_USE || !b->house_size) {
+            continue;
         }
+        if (!b->house_population) {
+            b->sickness_level = 0;
+            continue;
+        }
+        int house_health = city_health_get_house_health_level(b, 1);
+
+        total_population += b->house_population;
+        healthy_population += calc_adjust_with_percentage(b->house_population, house_health);
+        adjust_sickness_level_in_house(b, house_health, population_health_offset, hospital_coverage_bonus);
     }
     city_data.health.target_value = calc_percentage(healthy_population, total_population);
     if (city_data.health.value < city_data.health.target_value) {
@@ -3,6 +3,7 @@
 #include "building/building.h"
 #include "building/model.h"
 #include "building/monument.h"
+#include "core/array.h"
 #include "core/config.h"
 #include "city/data_private.h"
 #include "city/gods.h"
@@ -137,6 +138,68 @@ static struct {
     {LABOR_CATEGORY_GOVERNANCE_RELIGION, 1},
 };
 
+#define WORKPLACES_SIZE_STEP 100
+
+// In-use workplaces per category, in building type order and then in id order,
+// collected from the per-type building lists once per labor update
+static struct {
+    array(int) buildings[LABOR_CATEGORY_MAX];
+    struct {
+        building_type items[BUILDING_TYPE_MAX];
+        int total;
+    } types[LABOR_CATEGORY_MAX];
+    int types_initialized;
+} workplaces;
+
+static void init_types_per_category(void)
+{
+    for (building_type type = 0; type < BUILDING_TYPE_MAX; type++) {
+        int cat = CATEGORY_FOR_BUILDING_TYPE[type];
+        if (cat != LABOR_CATEGORY_NONE) {
+            workplaces.types[cat].items[workplaces.types[cat].total++] = type;
+        }
+    }
+    workplaces.types_initialized = 1;
+}
+
+static void add_workplace(int cat, int building_id)
+{
+    if (!workplaces.buildings[cat].blocks && !array_init(workplaces.buildings[cat], WORKPLACES_SIZE_STEP, 0, 0)) {
+        return;
+    }
+    int *element = array_advance(workplaces.buildings[cat]);
+    if (element) {
+        *element = building_id;
+    }
+}
+
+static void update_workplaces(void)
+{
+    if (!workplaces.types_initialized) {
+        init_types_per_category();
+    }
+    for (int cat = LABOR_CATEGORY_NONE + 1; cat < LABOR_CATEGORY_MAX; cat++) {
+        workplaces.buildings[cat].size = 0;
+        for (int i = 0; i < workplaces.types[cat].total; i++) {
+            for (building *b = building_first_of_type(workplaces.types[cat].items[i]); b; b = b->next_of_type) {
+                if (b->state == BUILDING_STATE_IN_USE) {
+                    add_workplace(cat, b->id);
+                }
+            }
+        }
+    }
+}
+
+static int workplaces_total(int cat)
+{
+    return workplaces.buildings[cat].size;
+}
+
+static building *workplace_get(int cat, int index)
+{
+    return building_get(*array_item(workplaces.buildings[cat], index));
+}
+
 int city_labor_unemployment_percentage(void)
 {
     return city_data.labor.unemployment_percentage;
@@ -273,21 +336,19 @@ static void calculate_workers_needed_per_category(void)
         city_data.labor.categories[cat].workers_allocated = 0;
         city_data.labor.categories[cat].workers_needed = 0;
     }
-    for (int i = 1; i < building_count(); i++) {
-        building *b = building_get(i);
-        if (b->state != BUILDING_STATE_IN_USE) {
-            continue;
-        }
-        int category = CATEGORY_FOR_BUILDING_TYPE[b->type];
-        b->labor_category = category - 1;
-        if (!should_have_workers(b, category, 1)) {
-            continue;
-        }
+    for (int category = LABOR_CATEGORY_NONE + 1; category < LABOR_CATEGORY_MAX; category++) {
+        for (int i = 0; i < workplaces_total(category); i++) {
+            building *b = workplace_get(category, i);
+            b->labor_category = category - 1;
+            if (!should_have_workers(b, category, 1)) {
+                continue;
+            }
 
-        city_data.labor.categories[category - 1].workers_needed += building_get_laborers(b->type);
+            city_data.labor.categories[category - 1].workers_needed += building_get_laborers(b->type);
 
-        city_data.labor.categories[category - 1].total_houses_covered += b->houses_covered;
-        city_data.labor.categories[category - 1].buildings++;
+            city_data.labor.categories[category - 1].total_houses_covered += b->houses_covered;
+            city_data.labor.categories[category - 1].buildings++;
+        }
     }
 }
 
@@ -389,15 +450,9 @@ static void check_employment(void)
 static void set_building_worker_weight(void)
 {
     int water_per_10k_per_building = calc_percentage(100, city_data.labor.categories[LABOR_CATEGORY_WATER - 1].buildings);
-    for (building_type type = 0; type < BUILDING_TYPE_MAX; type++) {
-        int cat = CATEGORY_FOR_BUILDING_TYPE[type];
-        if (cat == LABOR_CATEGORY_NONE) {
-            continue;
-        }
-        for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
-            if (b->state != BUILDING_STATE_IN_USE) {
-                continue;
-            }
+    for (int cat = LABOR_CATEGORY_NONE + 1; cat < LABOR_CATEGORY_MAX; cat++) {
+        for (int i = 0; i < workplaces_total(cat); i++) {
+            building *b = workplace_get(cat, i);
             if (cat == LABOR_CATEGORY_WATER) {
                 b->percentage_houses_covered = water_per_10k_per_building;
             } else {
@@ -428,16 +483,15 @@ static void allocate_workers_to_water(void)
     } else {
         workers_per_building = water_cat->workers_allocated / (water_cat->buildings - buildings_to_skip);
     }
-    int building_id = start_building_id;
+    // start at the first water building from the previous update's start id, wrapping around
+    int total = workplaces_total(LABOR_CATEGORY_WATER);
+    int first_index = 0;
+    while (first_index < total && workplace_get(LABOR_CATEGORY_WATER, first_index)->id < start_building_id) {
+        first_index++;
+    }
     start_building_id = 0;
-    for (int guard = 1; guard < building_count(); guard++, building_id++) {
-        if (building_id >= building_count()) {
-            building_id = 1;
-        }
-        building *b = building_get(building_id);
-        if (b->state != BUILDING_STATE_IN_USE || CATEGORY_FOR_BUILDING_TYPE[b->type] != LABOR_CATEGORY_WATER) {
-            continue;
-        }
+    for (int n = 0; n < total; n++) {
+        building *b = workplace_get(LABOR_CATEGORY_WATER, (first_index + n) % total);
         b->num_workers = 0;
         if (b->percentage_houses_covered > 0) {
             if (percentage_not_filled > 0) {
@@ -446,7 +500,7 @@ static void allocate_workers_to_water(void)
                 } else if (start_building_id) {
                     b->num_workers = workers_per_building;
                 } else {
-                    start_building_id = building_id;
+                    start_building_id = b->id;
                     b->num_workers = workers_per_building;
                 }
             } else {
@@ -470,16 +524,13 @@ static void allocate_workers_to_non_water_buildings(void)
             city_data.labor.categories[i].workers_allocated < city_data.labor.categories[i].workers_needed
             ? 1 : 0;
     }
-    for (building_type type = 0; type < BUILDING_TYPE_MAX; type++) {
-        int cat = CATEGORY_FOR_BUILDING_TYPE[type];
-        if (cat == LABOR_CATEGORY_WATER || cat == LABOR_CATEGORY_NONE) {
+    for (int cat = LABOR_CATEGORY_NONE + 1; cat < LABOR_CATEGORY_MAX; cat++) {
+        if (cat == LABOR_CATEGORY_WATER) {
             // water is handled by allocate_workers_to_water(void)
             continue;
         }
-        for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
-            if (b->state != BUILDING_STATE_IN_USE) {
-                continue;
-            }
+        for (int i = 0; i < workplaces_total(cat); i++) {
+            building *b = workplace_get(cat, i);
             b->num_workers = 0;
             if (b->type != BUILDING_LATRINES && (!should_have_workers(b, cat, 0) || b->percentage_houses_covered <= 0)) {
                 continue;
@@ -512,15 +563,12 @@ static void allocate_workers_to_non_water_buildings(void)
             }
         }
     }
-    for (building_type type = 0; type < BUILDING_TYPE_MAX; type++) {
-        int cat = CATEGORY_FOR_BUILDING_TYPE[type];
-        if (cat == LABOR_CATEGORY_NONE || cat == LABOR_CATEGORY_WATER || cat == LABOR_CATEGORY_MILITARY) {
+    for (int cat = LABOR_CATEGORY_NONE + 1; cat < LABOR_CATEGORY_MAX; cat++) {
+        if (cat == LABOR_CATEGORY_WATER || cat == LABOR_CATEGORY_MILITARY) {
             continue;
         }
-        for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
-            if (b->state != BUILDING_STATE_IN_USE) {
-                continue;
-            }
+        for (int i = 0; i < workplaces_total(cat); i++) {
+            building *b = workplace_get(cat, i);
             if (!should_have_workers(b, cat, 0)) {
                 continue;
             }
@@ -550,12 +598,14 @@ static void allocate_workers_to_buildings(void)
 
 void city_labor_allocate_workers(void)
 {
+    update_workplaces();
     allocate_workers_to_categories();
     allocate_workers_to_buildings();
 }
 
 void city_labor_update(void)
 {
+    update_workplaces();
     calculate_workers_needed_per_category();
     check_employment();
     allocate_workers_to_buildings();
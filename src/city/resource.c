@@ -7,6 +7,7 @@
 #include "building/industry.h"
 #include "building/model.h"
 #include "building/monument.h"
+#include "building/storage.h"
 #include "building/warehouse.h"
 #include "city/buildings.h"
 #include "city/data_private.h"
@@ -253,22 +254,26 @@ void city_resource_add_produced_to_granary(int amount)
 
 void city_resource_add_to_granary(resource_type food, int amount)
 {
+    building_storage_stock_changed();
     city_data.resource.granary_food_stored[food] += amount;
 }
 
 void city_resource_remove_from_granary(resource_type food, int amount)
 {
+    building_storage_stock_changed();
     city_data.resource.granary_food_stored[food] -= amount;
 }
 
 void city_resource_add_to_warehouse(resource_type resource, int amount)
 {
+    building_storage_stock_changed();
     city_data.resource.space_in_warehouses[resource] -= amount;
     city_data.resource.stored_in_warehouses[resource] += amount;
 }
 
 void city_resource_remove_from_warehouse(resource_type resource, int amount)
 {
+    building_storage_stock_changed();
     city_data.resource.space_in_warehouses[resource] += amount;
     city_data.resource.stored_in_warehouses[resource] -= amount;
 }
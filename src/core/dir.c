@@ -9,6 +9,8 @@
 #include <string.h>
 
 #define BASE_MAX_FILES 100
+#define CASE_CACHE_SIZE 1024
+#define CASE_CACHE_MAX_ENTRIES (CASE_CACHE_SIZE * 3 / 4)
 
 static struct {
     dir_listing listing;
@@ -17,6 +19,17 @@ static struct {
     char current_dir[FILE_NAME_MAX];
 } data;
 
+// Maps a requested path to the path it resolves to on disk, or to nothing if the file doesn't exist
+typedef struct {
+    char *requested;
+    char *resolved;
+} case_cache_entry;
+
+static struct {
+    case_cache_entry entries[CASE_CACHE_SIZE];
+    int total;
+} case_cache;
+
 static void allocate_listing_files(int min, int max)
 {
     for (int i = min; i < max; i++) {
@@ -113,6 +126,74 @@ static int correct_case(const char *dir, char *filename, int type)
     return platform_file_manager_list_directory_contents(dir, type, 0, compare_case) == LIST_MATCH;
 }
 
+static unsigned int hash_path(const char *path)
+{
+    unsigned int hash = 2166136261u;
+    while (*path) {
+        hash = (hash ^ (unsigned char) *path) * 16777619u;
+        path++;
+    }
+    return hash;
+}
+
+static case_cache_entry *get_case_cache_entry(const char *requested)
+{
+    unsigned int index = hash_path(requested) & (CASE_CACHE_SIZE - 1);
+    while (case_cache.entries[index].requested) {
+        if (strcmp(case_cache.entries[index].requested, requested) == 0) {
+            return &case_cache.entries[index];
+        }
+        index = (index + 1) & (CASE_CACHE_SIZE - 1);
+    }
+    return &case_cache.entries[index];
+}
+
+static char *copy_path(const char *path)
+{
+    size_t length = strlen(path) + 1;
+    char *copy = malloc(length);
+    if (copy) {
+        memcpy(copy, path, length);
+    }
+    return copy;
+}
+
+static void add_to_case_cache(const char *requested, const char *resolved)
+{
+    if (case_cache.total >= CASE_CACHE_MAX_ENTRIES) {
+        dir_invalidate_cache();
+    }
+    case_cache_entry *entry = get_case_cache_entry(requested);
+    if (entry->requested) {
+        return;
+    }
+    entry->requested = copy_path(requested);
+    if (!entry->requested) {
+        return;
+    }
+    if (resolved) {
+        entry->resolved = copy_path(resolved);
+        if (!entry->resolved) {
+            free(entry->requested);
+            entry->requested = 0;
+            return;
+        }
+    }
+    case_cache.total++;
+}
+
+void dir_invalidate_cache(void)
+{
+    if (!case_cache.total) {
+        return;
+    }
+    for (int i = 0; i < CASE_CACHE_SIZE; i++) {
+        free(case_cache.entries[i].requested);
+        free(case_cache.entries[i].resolved);
+    }
+    memset(&case_cache, 0, sizeof(case_cache));
+}
+
 static void move_left(char *str)
 {
     while (*str) {
@@ -156,13 +237,29 @@ static const char *get_case_corrected_file(const char *dir, const char *filepath
 
     snprintf(&corrected_filename[dir_len], 2 * FILE_NAME_MAX - dir_len, "%s", filepath);
 
+    case_cache_entry *cached = get_case_cache_entry(corrected_filename);
+    if (cached->requested) {
+        if (cached->resolved) {
+            snprintf(corrected_filename, 2 * FILE_NAME_MAX, "%s", cached->resolved);
+            return corrected_filename + dir_skip;
+        }
+        if (filepath == backup) {
+            snprintf(corrected_filename + backup_offset, 2 * FILE_NAME_MAX - backup_offset, "%s", backup);
+        }
+        return 0;
+    }
+    char requested[2 * FILE_NAME_MAX];
+    snprintf(requested, 2 * FILE_NAME_MAX, "%s", corrected_filename);
+
     FILE *fp = file_open(corrected_filename, "rb");
     if (fp) {
         file_close(fp);
+        add_to_case_cache(requested, corrected_filename);
         return corrected_filename + dir_skip;
     }
 
     if (!platform_file_manager_should_case_correct_file()) {
+        add_to_case_cache(requested, 0);
         if (filepath == backup) {
             snprintf(corrected_filename + backup_offset, 2 * FILE_NAME_MAX - backup_offset, "%s", backup);
         }
@@ -182,6 +279,7 @@ static const char *get_case_corrected_file(const char *dir, const char *filepath
         }
         *slash = 0;
         if (!correct_case(corrected_filename, &corrected_filename[path_offset], TYPE_DIR)) {
+            add_to_case_cache(requested, 0);
             if (filepath == backup) {
                 snprintf(corrected_filename + backup_offset, 2 * FILE_NAME_MAX - backup_offset, "%s", backup);
             }
@@ -196,12 +294,14 @@ static const char *get_case_corrected_file(const char *dir, const char *filepath
         path_offset += strlen(&corrected_filename[path_offset]) + 1;
     }
     if (!correct_case(corrected_filename, &corrected_filename[path_offset], TYPE_FILE)) {
+        add_to_case_cache(requested, 0);
         if (filepath == backup) {
             snprintf(corrected_filename + backup_offset, 2 * FILE_NAME_MAX - backup_offset, "%s", backup);
         }
         return 0;
     }
     corrected_filename[path_offset - 1] = '/';
+    add_to_case_cache(requested, corrected_filename);
     return corrected_filename + dir_skip;
 }
 
@@ -101,6 +101,11 @@ const char *dir_get_file(const char *filepath, int localizable);
  */
 const char *dir_get_file_at_location(const char *filepath, int location);
 
+/**
+ * Forgets all cached file lookups, must be called whenever files are added or removed
+ */
+void dir_invalidate_cache(void);
+
 /**
  * Appends the location to the filename
  * @param filename File path to append the location to
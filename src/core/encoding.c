@@ -928,8 +928,28 @@ int encoding_can_display(const char *utf8_char)
     return is_ascii(utf8_char) || get_letter_code_for_utf8(utf8_char, NULL, NULL) != NULL;
 }
 
+static int copy_ascii_prefix(const char *input, char *output, int output_length)
+{
+    int length = 0;
+    while (length < output_length - 1 && input[length] && is_ascii(&input[length])) {
+        output[length] = input[length];
+        length++;
+    }
+    output[length] = 0;
+    return length;
+}
+
 void encoding_to_utf8(const uint8_t *input, char *output, int output_length, int decomposed)
 {
+    // Most strings are plain ASCII, which is the same in every encoding
+    int ascii_length = copy_ascii_prefix((const char *) input, output, output_length);
+    if (!input[ascii_length] || ascii_length >= output_length - 1) {
+        return;
+    }
+    input += ascii_length;
+    output += ascii_length;
+    output_length -= ascii_length;
+
     if (!data.to_utf8_table) {
         if (data.encoding == ENCODING_KOREAN) {
             encoding_korean_to_utf8(input, output, output_length);
@@ -980,6 +1000,14 @@ void encoding_to_utf8(const uint8_t *input, char *output, int output_length, int
 
 void encoding_from_utf8(const char *input, uint8_t *output, int output_length)
 {
+    int ascii_length = copy_ascii_prefix(input, (char *) output, output_length);
+    if (!input[ascii_length] || ascii_length >= output_length - 1) {
+        return;
+    }
+    input += ascii_length;
+    output += ascii_length;
+    output_length -= ascii_length;
+
     if (!data.to_utf8_table) {
         if (data.encoding == ENCODING_KOREAN) {
             encoding_korean_from_utf8(input, output, output_length);
@@ -998,7 +1026,8 @@ void encoding_from_utf8(const char *input, uint8_t *output, int output_length)
 
     const uint8_t *max_output = &output[output_length - 1];
 
-    const char *prev_input = input;
+    // A combining character may follow the last copied ASCII character
+    const char *prev_input = ascii_length ? input - 1 : input;
     while (*input && output < max_output) {
         if (is_ascii(input)) {
             *output = *input;
@@ -1,27 +1,22 @@
 #include "encoding_japanese.h"
 
 #include "core/encoding.h"
+#include "core/encoding_multibyte.h"
 #include "core/image.h"
 #include "core/log.h"
 
 #include <stdlib.h>
-#include <string.h>
 
 #define HALF_WIDTH_START 0
 #define NUM_HALF_WIDTH 63
 #define FULL_WIDTH_START NUM_HALF_WIDTH
 
-typedef struct {
-    uint16_t cp932;
-    uint8_t utf8[3];
-} japanese_entry;
-
 typedef struct {
     uint16_t cp932;
     int image_id;
 } japanese_image_entry;
 
-static const japanese_entry codepage_to_utf8[] = {
+static const encoding_multibyte_entry codepage_to_utf8[] = {
     {0x8140, {0xe3, 0x80, 0x80}},
     {0x8141, {0xe3, 0x80, 0x81}},
     {0x8142, {0xe3, 0x80, 0x82}},
@@ -7277,9 +7272,9 @@ static const japanese_entry codepage_to_utf8[] = {
     {0xeefc, {0xef, 0xbc, 0x82}},
 };
 
-static japanese_entry *utf8_to_codepage;
+static encoding_multibyte_table table;
 
-static const int num_entries = sizeof(codepage_to_utf8) / sizeof(japanese_entry);
+static const int num_entries = sizeof(codepage_to_utf8) / sizeof(encoding_multibyte_entry);
 
 static const int image_id_block_indexes[128] = {
     // 80-8f
@@ -7343,39 +7338,14 @@ static const japanese_image_entry image_entries[] = {
     {0xea74, 3320},
 };
 
-static int compare_utf8(const void *a, const void *b)
-{
-    const uint8_t *va = ((const japanese_entry*) a)->utf8;
-    const uint8_t *vb = ((const japanese_entry*) b)->utf8;
-    for (int i = 0; i < 3; i++) {
-        if (va[i] == vb[i] || (va[i] == 0 || vb[i] == 0)) {
-            continue;
-        }
-        return va[i] < vb[i] ? -1 : 1;
-    }
-    return 0;
-}
-
-static int compare_codepage(const void *a, const void *b)
-{
-    uint16_t va = ((const japanese_entry*) a)->cp932;
-    uint16_t vb = ((const japanese_entry*) b)->cp932;
-    return va == vb ? 0 : (va < vb ? -1 : 1);
-}
-
 void encoding_japanese_init(void)
 {
-    if (!utf8_to_codepage) {
-        utf8_to_codepage = (japanese_entry*) malloc(sizeof(codepage_to_utf8));
-        if (!utf8_to_codepage) {
-            log_error("Unable to allocate memory for Japanese codepage", 0, 0);
-            return;
-        }
+    if (table.entries) {
+        return;
+    }
+    if (!encoding_multibyte_init(&table, codepage_to_utf8, num_entries)) {
+        log_error("Unable to allocate memory for Japanese codepage", 0, 0);
     }
-    // codepage_to_unicode is already sorted, copy data and sort the other way around
-    memcpy(utf8_to_codepage, codepage_to_utf8, sizeof(codepage_to_utf8));
-
-    qsort(utf8_to_codepage, sizeof(codepage_to_utf8) / sizeof(japanese_entry), sizeof(japanese_entry), compare_utf8);
 }
 
 void encoding_japanese_to_utf8(const uint8_t *input, char *output, int output_length)
@@ -7390,9 +7360,8 @@ void encoding_japanese_to_utf8(const uint8_t *input, char *output, int output_le
         } else {
             // Possibly multi-byte char
             int is_kata = input[0] >= 0xa0 && input[0] < 0xe0;
-            const japanese_entry key = {input[0] << 8 | (is_kata ? 0 : input[1])};
-            const japanese_entry *entry = bsearch(&key, codepage_to_utf8,
-                num_entries, sizeof(japanese_entry), compare_codepage);
+            const encoding_multibyte_entry *entry =
+                encoding_multibyte_from_codepage(&table, input[0] << 8 | (is_kata ? 0 : input[1]));
             if (entry && output + 3 <= max_output) {
                 for (int i = 0; i < 3 && entry->utf8[i]; i++) {
                     *output = entry->utf8[i];
@@ -7407,7 +7376,7 @@ void encoding_japanese_to_utf8(const uint8_t *input, char *output, int output_le
 
 void encoding_japanese_from_utf8(const char *input, uint8_t *output, int output_length)
 {
-    if (!utf8_to_codepage) {
+    if (!table.entries) {
         output[0] = 0;
         return;
     }
@@ -7420,17 +7389,15 @@ void encoding_japanese_from_utf8(const char *input, uint8_t *output, int output_
             ++input;
         } else {
             // Multi-byte char: Japanese characters are 2 or 3 bytes in utf-8
-            const japanese_entry key = {0, {(uint8_t)input[0], (uint8_t)input[1], (uint8_t)input[2]}};
-            const japanese_entry *entry = bsearch(&key, utf8_to_codepage,
-                num_entries, sizeof(japanese_entry), compare_utf8);
+            const encoding_multibyte_entry *entry = encoding_multibyte_from_utf8(&table, input);
             if (entry) {
                 // Either 1 or 2 bytes in output
-                int output_size = entry->cp932 & 0xff ? 2 : 1;
+                int output_size = entry->codepage & 0xff ? 2 : 1;
                 if (output + output_size <= max_output) {
-                    *output = (entry->cp932 >> 8) & 0xff;
+                    *output = (entry->codepage >> 8) & 0xff;
                     output++;
                     if (output_size == 2) {
-                        *output = entry->cp932 & 0xff;
+                        *output = entry->codepage & 0xff;
                         output++;
                     }
                     input += entry->utf8[2] ? 3 : 2;
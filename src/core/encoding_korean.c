@@ -1,18 +1,11 @@
 #include "encoding_korean.h"
 
 #include "core/encoding.h"
+#include "core/encoding_multibyte.h"
 #include "core/image.h"
 #include "core/log.h"
 
-#include <stdlib.h>
-#include <string.h>
-
-typedef struct {
-    uint16_t cp949;
-    uint8_t utf8[3];
-} korean_entry;
-
-static const korean_entry codepage_to_utf8[IMAGE_FONT_MULTIBYTE_KOREAN_MAX_CHARS] = {
+static const encoding_multibyte_entry codepage_to_utf8[IMAGE_FONT_MULTIBYTE_KOREAN_MAX_CHARS] = {
     {0xb0a1, {0xea, 0xb0, 0x80}},
     {0xb0a2, {0xea, 0xb0, 0x81}},
     {0xb0a3, {0xea, 0xb0, 0x84}},
@@ -2365,42 +2358,16 @@ static const korean_entry codepage_to_utf8[IMAGE_FONT_MULTIBYTE_KOREAN_MAX_CHARS
     {0xc8fe, {0xed, 0x9e, 0x9d}}
 };
 
-static korean_entry *utf8_to_codepage;
-
-static int compare_utf8(const void *a, const void *b)
-{
-    const uint8_t *va = ((const korean_entry*) a)->utf8;
-    const uint8_t *vb = ((const korean_entry*) b)->utf8;
-    for (int i = 0; i < 3; i++) {
-        if (va[i] == vb[i]) {
-            continue;
-        }
-        return va[i] < vb[i] ? -1 : 1;
-    }
-    return 0;
-}
-
-static int compare_codepage(const void *a, const void *b)
-{
-    uint16_t va = ((const korean_entry*) a)->cp949;
-    uint16_t vb = ((const korean_entry*) b)->cp949;
-    return va == vb ? 0 : (va < vb ? -1 : 1);
-}
+static encoding_multibyte_table table;
 
 void encoding_korean_init(void)
 {
-    if (!utf8_to_codepage) {
-        utf8_to_codepage = (korean_entry*) malloc(sizeof(korean_entry) * IMAGE_FONT_MULTIBYTE_KOREAN_MAX_CHARS);
-        if (!utf8_to_codepage) {
-            log_error("Unable to allocate memory for Korean codepage", 0, 0);
-            return;
-        }
+    if (table.entries) {
+        return;
+    }
+    if (!encoding_multibyte_init(&table, codepage_to_utf8, IMAGE_FONT_MULTIBYTE_KOREAN_MAX_CHARS)) {
+        log_error("Unable to allocate memory for Korean codepage", 0, 0);
     }
-    // codepage_to_unicode is already sorted, copy data and sort the other way around
-    memcpy(utf8_to_codepage, codepage_to_utf8,
-        IMAGE_FONT_MULTIBYTE_KOREAN_MAX_CHARS * sizeof(korean_entry));
-
-    qsort(utf8_to_codepage, IMAGE_FONT_MULTIBYTE_KOREAN_MAX_CHARS, sizeof(korean_entry), compare_utf8);
 }
 
 void encoding_korean_to_utf8(const uint8_t *input, char *output, int output_length)
@@ -2414,9 +2381,8 @@ void encoding_korean_to_utf8(const uint8_t *input, char *output, int output_leng
             ++input;
         } else {
             // multi-byte char
-            const korean_entry key = {input[0] << 8 | input[1]};
-            const korean_entry *entry = bsearch(&key, codepage_to_utf8,
-                IMAGE_FONT_MULTIBYTE_KOREAN_MAX_CHARS, sizeof(korean_entry), compare_codepage);
+            const encoding_multibyte_entry *entry =
+                encoding_multibyte_from_codepage(&table, input[0] << 8 | input[1]);
             if (entry && output + 3 <= max_output) {
                 for (int i = 0; i < 3; i++) {
                     *output = entry->utf8[i];
@@ -2431,7 +2397,7 @@ void encoding_korean_to_utf8(const uint8_t *input, char *output, int output_leng
 
 void encoding_korean_from_utf8(const char *input, uint8_t *output, int output_length)
 {
-    if (!utf8_to_codepage) {
+    if (!table.entries) {
         output[0] = 0;
         return;
     }
@@ -2444,13 +2410,11 @@ void encoding_korean_from_utf8(const char *input, uint8_t *output, int output_le
             ++input;
         } else {
             // multi-byte char: Korean characters are always 3 bytes in utf-8
-            const korean_entry key = {0, {(uint8_t)input[0], (uint8_t)input[1], (uint8_t)input[2]}};
-            const korean_entry *entry = bsearch(&key, utf8_to_codepage,
-                IMAGE_FONT_MULTIBYTE_KOREAN_MAX_CHARS, sizeof(korean_entry), compare_utf8);
+            const encoding_multibyte_entry *entry = encoding_multibyte_from_utf8(&table, input);
             if (entry && output + 2 <= max_output) {
-                *output = (entry->cp949 >> 8) & 0xff;
+                *output = (entry->codepage >> 8) & 0xff;
                 output++;
-                *output = entry->cp949 & 0xff;
+                *output = entry->codepage & 0xff;
                 output++;
                 input += 3;
             } else {
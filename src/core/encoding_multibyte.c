@@ -0,0 +1,106 @@
+#include "encoding_multibyte.h"
+
+#include <stdlib.h>
+
+#define MIN_SLOT_BITS 4
+
+static uint32_t utf8_key(const uint8_t *utf8)
+{
+    if ((utf8[0] & 0xe0) == 0xc0 || !utf8[1]) {
+        return utf8[0] | utf8[1] << 8;
+    }
+    return utf8[0] | utf8[1] << 8 | utf8[2] << 16;
+}
+
+static uint32_t entry_utf8_key(const encoding_multibyte_entry *entry)
+{
+    return utf8_key(entry->utf8);
+}
+
+static uint32_t entry_codepage_key(const encoding_multibyte_entry *entry)
+{
+    return entry->codepage;
+}
+
+static int first_slot(const encoding_multibyte_table *table, uint32_t key)
+{
+    return (int) ((key * 2654435761u) >> (32 - table->slot_bits));
+}
+
+static const encoding_multibyte_entry *find(const encoding_multibyte_table *table, const uint16_t *slots,
+    uint32_t key, uint32_t (*key_of)(const encoding_multibyte_entry *))
+{
+    int mask = (1 << table->slot_bits) - 1;
+    for (int slot = first_slot(table, key); slots[slot]; slot = (slot + 1) & mask) {
+        const encoding_multibyte_entry *entry = &table->entries[slots[slot] - 1];
+        if (key_of(entry) == key) {
+            return entry;
+        }
+    }
+    return 0;
+}
+
+static void insert(const encoding_multibyte_table *table, uint16_t *slots,
+    int index, uint32_t (*key_of)(const encoding_multibyte_entry *))
+{
+    uint32_t key = key_of(&table->entries[index]);
+    int mask = (1 << table->slot_bits) - 1;
+    int slot = first_slot(table, key);
+    while (slots[slot]) {
+        if (key_of(&table->entries[slots[slot] - 1]) == key) {
+            // Some codepages map several values to the same character, keep the first one
+            return;
+        }
+        slot = (slot + 1) & mask;
+    }
+    slots[slot] = (uint16_t) (index + 1);
+}
+
+int encoding_multibyte_init(encoding_multibyte_table *table,
+    const encoding_multibyte_entry *entries, int num_entries)
+{
+    free(table->codepage_slots);
+    free(table->utf8_slots);
+    table->entries = 0;
+    table->num_entries = 0;
+
+    // Keep the tables at most half full so probe sequences stay short
+    table->slot_bits = MIN_SLOT_BITS;
+    while ((1 << table->slot_bits) < num_entries * 2) {
+        table->slot_bits++;
+    }
+    table->codepage_slots = calloc(1 << table->slot_bits, sizeof(uint16_t));
+    table->utf8_slots = calloc(1 << table->slot_bits, sizeof(uint16_t));
+    if (!table->codepage_slots || !table->utf8_slots) {
+        free(table->codepage_slots);
+        free(table->utf8_slots);
+        table->codepage_slots = 0;
+        table->utf8_slots = 0;
+        return 0;
+    }
+    table->entries = entries;
+    table->num_entries = num_entries;
+    for (int i = 0; i < num_entries; i++) {
+        insert(table, table->codepage_slots, i, entry_codepage_key);
+        insert(table, table->utf8_slots, i, entry_utf8_key);
+    }
+    return 1;
+}
+
+const encoding_multibyte_entry *encoding_multibyte_from_codepage(const encoding_multibyte_table *table,
+    uint16_t codepage)
+{
+    if (!table->entries) {
+        return 0;
+    }
+    return find(table, table->codepage_slots, codepage, entry_codepage_key);
+}
+
+const encoding_multibyte_entry *encoding_multibyte_from_utf8(const encoding_multibyte_table *table,
+    const char *utf8)
+{
+    if (!table->entries) {
+        return 0;
+    }
+    return find(table, table->utf8_slots, utf8_key((const uint8_t *) utf8), entry_utf8_key);
+}
@@ -0,0 +1,53 @@
+#ifndef CORE_ENCODING_MULTIBYTE_H
+#define CORE_ENCODING_MULTIBYTE_H
+
+#include <stdint.h>
+
+/**
+ * A single character of a multibyte codepage
+ */
+typedef struct {
+    uint16_t codepage;
+    uint8_t utf8[3];
+} encoding_multibyte_entry;
+
+/**
+ * Lookup table for a multibyte codepage, indexed both ways
+ */
+typedef struct {
+    const encoding_multibyte_entry *entries;
+    int num_entries;
+    uint16_t *codepage_slots;
+    uint16_t *utf8_slots;
+    int slot_bits;
+} encoding_multibyte_table;
+
+/**
+ * Builds the hashed lookups for the codepage, without sorting
+ * @param table Table to initialize
+ * @param entries Characters of the codepage, utf8 values of two bytes end with a zero byte
+ * @param num_entries Number of characters
+ * @return 1 on success, 0 when there was not enough memory
+ */
+int encoding_multibyte_init(encoding_multibyte_table *table,
+    const encoding_multibyte_entry *entries, int num_entries);
+
+/**
+ * Finds the character for a codepage value
+ * @param table Initialized table
+ * @param codepage Codepage value
+ * @return Character, or 0 when the codepage value is unknown
+ */
+const encoding_multibyte_entry *encoding_multibyte_from_codepage(const encoding_multibyte_table *table,
+    uint16_t codepage);
+
+/**
+ * Finds the character for the utf-8 character at the start of the input
+ * @param table Initialized table
+ * @param utf8 UTF-8 input, at least three bytes or null-terminated
+ * @return Character, or 0 when the codepage has no such character
+ */
+const encoding_multibyte_entry *encoding_multibyte_from_utf8(const encoding_multibyte_table *table,
+    const char *utf8);
+
+#endif // CORE_ENCODING_MULTIBYTE_H
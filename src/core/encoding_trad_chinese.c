@@ -1,18 +1,11 @@
 #include "encoding_trad_chinese.h"
 
 #include "core/encoding.h"
+#include "core/encoding_multibyte.h"
 #include "core/image.h"
 #include "core/log.h"
 
-#include <stdlib.h>
-#include <string.h>
-
-typedef struct {
-    uint16_t internal;
-    uint8_t utf8[3];
-} chinese_entry;
-
-static const chinese_entry codepage_to_utf8[IMAGE_FONT_MULTIBYTE_TRAD_CHINESE_MAX_CHARS] = {
+static const encoding_multibyte_entry codepage_to_utf8[IMAGE_FONT_MULTIBYTE_TRAD_CHINESE_MAX_CHARS] = {
     {0x8080, {0xef, 0xbc, 0x81}},
     {0x8081, {0xe6, 0xaa, 0x94}},
     {0x8082, {0xe6, 0xa1, 0x88}},
@@ -2203,7 +2196,7 @@ static const chinese_entry codepage_to_utf8[IMAGE_FONT_MULTIBYTE_TRAD_CHINESE_MA
     {0x918b, {0xe5, 0xbe, 0xb9}}
 };
 
-static chinese_entry *utf8_to_codepage;
+static encoding_multibyte_table table;
 
 typedef struct {
     uint16_t image_id;
@@ -2235,41 +2228,14 @@ static image_entry image_entries[] = {
     {0, 0}
 };
 
-static int compare_utf8(const void *a, const void *b)
-{
-    const uint8_t *va = ((const chinese_entry*) a)->utf8;
-    const uint8_t *vb = ((const chinese_entry*) b)->utf8;
-    for (int i = 0; i < 3; i++) {
-        if (va[i] == vb[i] || (va[i] == 0 || vb[i] == 0)) {
-            continue;
-        }
-        return va[i] < vb[i] ? -1 : 1;
-    }
-    return 0;
-}
-
-static int compare_internal(const void *a, const void *b)
-{
-    uint16_t va = ((const chinese_entry*) a)->internal;
-    uint16_t vb = ((const chinese_entry*) b)->internal;
-    return va == vb ? 0 : (va < vb ? -1 : 1);
-}
-
 void encoding_trad_chinese_init(void)
 {
-    if (!utf8_to_codepage) {
-        utf8_to_codepage =
-            (chinese_entry*) malloc(sizeof(chinese_entry) * IMAGE_FONT_MULTIBYTE_TRAD_CHINESE_MAX_CHARS);
-        if (!utf8_to_codepage) {
-            log_error("Unable to allocate memory for Chinese codepage", 0, 0);
-            return;
-        }
+    if (table.entries) {
+        return;
+    }
+    if (!encoding_multibyte_init(&table, codepage_to_utf8, IMAGE_FONT_MULTIBYTE_TRAD_CHINESE_MAX_CHARS)) {
+        log_error("Unable to allocate memory for Chinese codepage", 0, 0);
     }
-    // codepage_to_utf8 is already sorted, copy data and sort the other way around
-    memcpy(utf8_to_codepage, codepage_to_utf8,
-        IMAGE_FONT_MULTIBYTE_TRAD_CHINESE_MAX_CHARS * sizeof(chinese_entry));
-
-    qsort(utf8_to_codepage, IMAGE_FONT_MULTIBYTE_TRAD_CHINESE_MAX_CHARS, sizeof(chinese_entry), compare_utf8);
 }
 
 void encoding_trad_chinese_to_utf8(const uint8_t *input, char *output, int output_length)
@@ -2283,9 +2249,8 @@ void encoding_trad_chinese_to_utf8(const uint8_t *input, char *output, int outpu
             ++input;
         } else {
             // multi-byte char
-            const chinese_entry key = {input[1] << 8 | input[0]};
-            const chinese_entry *entry = bsearch(&key, codepage_to_utf8,
-                IMAGE_FONT_MULTIBYTE_TRAD_CHINESE_MAX_CHARS, sizeof(chinese_entry), compare_internal);
+            const encoding_multibyte_entry *entry =
+                encoding_multibyte_from_codepage(&table, input[1] << 8 | input[0]);
             int bytes = entry ? (entry->utf8[2] ? 3 : 2) : 0;
             if (entry && output + bytes <= max_output) {
                 for (int i = 0; i < bytes; i++) {
@@ -2301,7 +2266,7 @@ void encoding_trad_chinese_to_utf8(const uint8_t *input, char *output, int outpu
 
 void encoding_trad_chinese_from_utf8(const char *input, uint8_t *output, int output_length)
 {
-    if (!utf8_to_codepage) {
+    if (!table.entries) {
         output[0] = 0;
         return;
     }
@@ -2314,13 +2279,11 @@ void encoding_trad_chinese_from_utf8(const char *input, uint8_t *output, int out
             ++input;
         } else {
             // multi-byte char: Chinese characters from the table may be 2 or 3 bytes in UTF-8
-            const chinese_entry key = {0, {(uint8_t)input[0], (uint8_t)input[1], (uint8_t)input[2]}};
-            const chinese_entry *entry = bsearch(&key, utf8_to_codepage,
-                IMAGE_FONT_MULTIBYTE_TRAD_CHINESE_MAX_CHARS, sizeof(chinese_entry), compare_utf8);
+            const encoding_multibyte_entry *entry = encoding_multibyte_from_utf8(&table, input);
             if (entry && output + 2 <= max_output) {
-                *output = entry->internal & 0xff;
+                *output = entry->codepage & 0xff;
                 output++;
-                *output = (entry->internal >> 8) & 0xff;
+                *output = (entry->codepage >> 8) & 0xff;
                 output++;
                 input += entry->utf8[2] ? 3 : 2;
             } else {
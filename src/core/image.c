@@ -1101,6 +1101,7 @@ static int load_multibyte_font(multibyte_font_type type)
 
 int image_load_fonts(encoding_type encoding)
 {
+    font_mark_changed();
     graphics_renderer()->get_max_image_size(&data.max_image_width, &data.max_image_height);
 
     if (encoding == ENCODING_CYRILLIC) {
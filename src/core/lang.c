@@ -21,8 +21,6 @@
 #define MIN_MESSAGE_SIZE 32024
 #define MAX_MESSAGE_SIZE (MIN_MESSAGE_SIZE + MAX_MESSAGE_DATA)
 
-#define BUFFER_SIZE 400000
-
 #define FILE_TEXT_ENG "c3.eng"
 #define FILE_MM_ENG "c3_mm.eng"
 #define FILE_TEXT_RUS "c3.rus"
@@ -37,10 +35,12 @@ static struct {
         int32_t offset;
         int32_t in_use;
     } text_entries[MAX_TEXT_ENTRIES];
-    uint8_t text_data[MAX_TEXT_DATA];
+    // The files are read straight into these buffers and their strings are used in place.
+    // One extra byte lets an oversized text file be told apart from one of the maximum size
+    uint8_t text_file[MAX_TEXT_SIZE + 1];
 
     lang_message message_entries[MAX_MESSAGE_ENTRIES];
-    uint8_t message_data[MAX_MESSAGE_DATA];
+    uint8_t message_file[MAX_MESSAGE_SIZE];
 } data;
 
 static int file_exists_in_dir(const char *dir, const char *file)
@@ -68,17 +68,16 @@ static void parse_text(buffer *buf)
         data.text_entries[i].offset = buffer_read_i32(buf);
         data.text_entries[i].in_use = buffer_read_i32(buf);
     }
-    buffer_read_raw(buf, data.text_data, MAX_TEXT_DATA);
 }
 
-static int load_text(const char *filename, int localizable, uint8_t *buf_data)
+static int load_text(const char *filename, int localizable)
 {
     buffer buf;
-    int filesize = io_read_file_into_buffer(filename, localizable, buf_data, BUFFER_SIZE);
+    int filesize = io_read_file_into_buffer(filename, localizable, data.text_file, sizeof(data.text_file));
     if (filesize < MIN_TEXT_SIZE || filesize > MAX_TEXT_SIZE) {
         return 0;
     }
-    buffer_init(&buf, buf_data, filesize);
+    buffer_init(&buf, data.text_file, filesize);
     parse_text(&buf);
     return 1;
 }
@@ -96,7 +95,7 @@ static uint8_t *get_message_text(int32_t offset)
             return try_translation;
         }
     }
-    return &data.message_data[offset];
+    return &data.message_file[MIN_MESSAGE_SIZE + offset];
 }
 
 static void parse_message(buffer *buf)
@@ -131,7 +130,6 @@ static void parse_message(buffer *buf)
         m->subtitle.text = get_message_text(buffer_read_i32(buf));
         m->content.text = get_message_text(buffer_read_i32(buf));
     }
-    buffer_read_raw(buf, &data.message_data, MAX_MESSAGE_DATA);
 }
 
 
@@ -317,27 +315,22 @@ void load_augustus_messages(void)
 }
 
 
-static int load_message(const char *filename, int localizable, uint8_t *data_buffer)
+static int load_message(const char *filename, int localizable)
 {
     buffer buf;
-    int filesize = io_read_file_into_buffer(filename, localizable, data_buffer, BUFFER_SIZE);
-    if (filesize < MIN_MESSAGE_SIZE || filesize > MAX_MESSAGE_SIZE) {
+    // Oversized message files have always been accepted, only their start is used
+    int filesize = io_read_file_into_buffer(filename, localizable, data.message_file, MAX_MESSAGE_SIZE);
+    if (filesize < MIN_MESSAGE_SIZE) {
         return 0;
     }
-    buffer_init(&buf, data_buffer, filesize);
+    buffer_init(&buf, data.message_file, filesize);
     parse_message(&buf);
     return 1;
 }
 
 static int load_files(const char *text_filename, const char *message_filename, int localizable)
 {
-    uint8_t *buf = (uint8_t *) malloc(BUFFER_SIZE);
-    if (!buf) {
-        return 0;
-    }
-    int success = load_text(text_filename, localizable, buf) && load_message(message_filename, localizable, buf);
-    free(buf);
-    return success;
+    return load_text(text_filename, localizable) && load_message(message_filename, localizable);
 }
 
 int lang_load(int is_editor)
@@ -627,7 +620,7 @@ const uint8_t *lang_get_string(int group, int index)
         }
     }
 
-    const uint8_t *str = &data.text_data[data.text_entries[group].offset];
+    const uint8_t *str = &data.text_file[MIN_TEXT_SIZE + data.text_entries[group].offset];
     uint8_t prev = 0;
     while (index > 0) {
         if (!*str && (prev >= ' ' || prev == 0)) {
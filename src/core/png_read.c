@@ -12,6 +12,8 @@
 #include <string.h>
 
 #define BYTES_PER_PIXEL 4
+#define MAX_DECODED_FILES 8
+#define MAX_DECODED_FILES_SIZE (64 * 1024 * 1024)
 
 typedef enum {
     CACHE_TYPE_NONE = 0,
@@ -29,15 +31,107 @@ static struct {
         int width;
         int height;
         color_t *pixels;
+        int pixels_are_shared;
     } cache;
+    // Recently decoded files, so assets whose layers alternate between files don't decode them again
+    struct {
+        struct {
+            char path[FILE_NAME_MAX];
+            int width;
+            int height;
+            size_t size;
+            color_t *pixels;
+            unsigned int last_used;
+        } files[MAX_DECODED_FILES];
+        size_t total_size;
+        unsigned int use_counter;
+    } decoded;
 } data;
 
+static void close_png(void)
+{
+    spng_ctx_free(data.ctx);
+    data.ctx = 0;
+    if (data.fp) {
+        file_close(data.fp);
+        data.fp = 0;
+    }
+}
+
+static void close_current(void)
+{
+    close_png();
+    if (!data.cache.pixels_are_shared) {
+        free(data.cache.pixels);
+    }
+    memset(&data.cache, 0, sizeof(data.cache));
+}
+
+static int use_decoded_file(const char *path)
+{
+    for (int i = 0; i < MAX_DECODED_FILES; i++) {
+        if (data.decoded.files[i].pixels && strcmp(data.decoded.files[i].path, path) == 0) {
+            data.decoded.files[i].last_used = ++data.decoded.use_counter;
+            data.cache.type = CACHE_TYPE_FILE;
+            snprintf(data.cache.path, FILE_NAME_MAX, "%s", path);
+            data.cache.width = data.decoded.files[i].width;
+            data.cache.height = data.decoded.files[i].height;
+            data.cache.pixels = data.decoded.files[i].pixels;
+            data.cache.pixels_are_shared = 1;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void free_decoded_file(int index)
+{
+    data.decoded.total_size -= data.decoded.files[index].size;
+    free(data.decoded.files[index].pixels);
+    memset(&data.decoded.files[index], 0, sizeof(data.decoded.files[index]));
+}
+
+static void add_current_to_decoded_files(size_t size)
+{
+    if (data.cache.type != CACHE_TYPE_FILE || size > MAX_DECODED_FILES_SIZE) {
+        return;
+    }
+    int free_index;
+    do {
+        free_index = -1;
+        int least_used_index = 0;
+        for (int i = 0; i < MAX_DECODED_FILES; i++) {
+            if (!data.decoded.files[i].pixels) {
+                free_index = i;
+            } else if (data.decoded.files[i].last_used < data.decoded.files[least_used_index].last_used ||
+                !data.decoded.files[least_used_index].pixels) {
+                least_used_index = i;
+            }
+        }
+        if (free_index == -1 || data.decoded.total_size + size > MAX_DECODED_FILES_SIZE) {
+            free_decoded_file(least_used_index);
+            free_index = -1;
+        }
+    } while (free_index == -1);
+    snprintf(data.decoded.files[free_index].path, FILE_NAME_MAX, "%s", data.cache.path);
+    data.decoded.files[free_index].width = data.cache.width;
+    data.decoded.files[free_index].height = data.cache.height;
+    data.decoded.files[free_index].size = size;
+    data.decoded.files[free_index].pixels = data.cache.pixels;
+    data.decoded.files[free_index].last_used = ++data.decoded.use_counter;
+    data.decoded.total_size += size;
+    data.cache.pixels_are_shared = 1;
+}
+
 int png_load_from_file(const char *path, int is_asset)
 {
     if (data.cache.type == CACHE_TYPE_FILE && strcmp(path, data.cache.path) == 0) {
         return 1;
     }
-    png_unload();
+    close_current();
+    if (use_decoded_file(path)) {
+        return 1;
+    }
     data.fp = is_asset ? file_open_asset(path, "rb") : file_open(path, "rb");
     if (!data.fp) {
         log_error("Unable to open png file", path, 0);
@@ -46,12 +140,12 @@ int png_load_from_file(const char *path, int is_asset)
     data.ctx = spng_ctx_new(0);
     if (!data.ctx) {
         log_error("Unable to create a png handle context", 0, 0);
-        png_unload();
+        close_current();
         return 0;
     }
     if (spng_set_png_file(data.ctx, data.fp)) {
         log_error("Unable to set png file stream", 0, 0);
-        png_unload();
+        close_current();
         return 0;
     }
     data.cache.type = CACHE_TYPE_FILE;
@@ -64,7 +158,7 @@ int png_load_from_buffer(const uint8_t *buffer, size_t length)
     if (data.cache.type == CACHE_TYPE_MEMORY && buffer == data.cache.buffer) {
         return 1;
     }
-    png_unload();
+    close_current();
     if (!buffer) {
         log_error("Unable to open png file - no buffer provided", 0, 0);
         return 0;
@@ -72,12 +166,12 @@ int png_load_from_buffer(const uint8_t *buffer, size_t length)
     data.ctx = spng_ctx_new(0);
     if (!data.ctx) {
         log_error("Unable to create a png handle context", 0, 0);
-        png_unload();
+        close_current();
         return 0;
     }
     if (spng_set_png_buffer(data.ctx, buffer, length)) {
         log_error("Unable to set png buffer", 0, 0);
-        png_unload();
+        close_current();
         return 0;
     }
     data.cache.type = CACHE_TYPE_MEMORY;
@@ -121,38 +215,29 @@ static void convert_image_to_argb(color_t *pixels, int total_pixels)
     }
 }
 
-static void close_png(void)
-{
-    spng_ctx_free(data.ctx);
-    data.ctx = 0;
-    if (data.fp) {
-        file_close(data.fp);
-        data.fp = 0;
-    }
-}
-
 static int load_image(void)
 {
     size_t image_size;
     if (spng_decoded_image_size(data.ctx, SPNG_FMT_RGBA8, &image_size)) {
         log_error("Unable to retrieve png image size", 0, 0);
-        png_unload();
+        close_current();
         return 0;
     }
     int total_pixels = data.cache.width * data.cache.height;
     data.cache.pixels = malloc(image_size);
     if (!data.cache.pixels) {
         log_error("Unable to load png file. Out of memory", 0, 0);
-        png_unload();
+        close_current();
         return 0;
     }
     if (spng_decode_image(data.ctx, data.cache.pixels, image_size, SPNG_FMT_RGBA8, SPNG_DECODE_TRNS)) {
         log_error("Unable to start decoding png file", 0, 0);
-        png_unload();
+        close_current();
         return 0;
     }
     convert_image_to_argb(data.cache.pixels, total_pixels);
     close_png();
+    add_current_to_decoded_files(image_size);
     return 1;
 }
 
@@ -199,7 +284,11 @@ int png_read(color_t *pixels, int src_x, int src_y, int width, int height,
 
 void png_unload(void)
 {
-    close_png();
-    free(data.cache.pixels);
-    memset(&data.cache, 0, sizeof(data.cache));
+    close_current();
+    for (int i = 0; i < MAX_DECODED_FILES; i++) {
+        if (data.decoded.files[i].pixels) {
+            free_decoded_file(i);
+        }
+    }
+    data.decoded.use_counter = 0;
 }
@@ -9,6 +9,7 @@
 #include "game/resource.h"
 #include "game/save_version.h"
 #include "empire/city.h"
+#include "figure/image.h"
 #include "figure/name.h"
 #include "figure/route.h"
 #include "figure/trader.h"
@@ -282,7 +283,7 @@ static void figure_save(buffer *buf, const figure *f)
     buffer_write_u8(buf, f->image_offset);
     buffer_write_u8(buf, f->is_enemy_image);
     buffer_write_u8(buf, f->flotsam_visible);
-    buffer_write_i16(buf, f->image_id);
+    buffer_write_i16(buf, figure_image_get(f));
     buffer_write_i16(buf, f->cart_image_id);
     buffer_write_i16(buf, f->next_figure_id_on_same_tile);
     buffer_write_u8(buf, f->type);
@@ -13,6 +13,7 @@ typedef struct {
 
     unsigned int image_id;
     unsigned int cart_image_id;
+    unsigned int deferred_image_base;
     unsigned char image_offset;
     unsigned char is_enemy_image;
 
@@ -39,13 +39,25 @@ static const int LEGION_MISSILE_LAUNCHER_OFFSETS[128] = {
 static const int CART_OFFSETS_X[] = {13, 18, 12, 0, -13, -18, -13, 0};
 static const int CART_OFFSETS_Y[] = {-7, -1, 7, 11, 6, -1, -7, -12};
 
+#define IMAGE_DEFERRED 0xffffffff
+
 void figure_image_update(figure *f, int image_base)
 {
+    // Most walkers are off screen, so the image is worked out when drawing or saving.
+    // Setting image_id directly afterwards replaces the deferred image
+    f->deferred_image_base = image_base;
+    f->image_id = IMAGE_DEFERRED;
+}
+
+unsigned int figure_image_get(const figure *f)
+{
+    if (f->image_id != IMAGE_DEFERRED) {
+        return f->image_id;
+    }
     if (f->action_state == FIGURE_ACTION_149_CORPSE) {
-        f->image_id = image_base + CORPSE_IMAGE_OFFSETS[f->wait_ticks / 2] + 96;
-    } else {
-        f->image_id = image_base + figure_image_direction(f) + 8 * f->image_offset;
+        return f->deferred_image_base + CORPSE_IMAGE_OFFSETS[f->wait_ticks / 2] + 96;
     }
+    return f->deferred_image_base + figure_image_direction(f) + 8 * f->image_offset;
 }
 
 void figure_image_increase_offset(figure *f, int max)
@@ -77,7 +89,7 @@ int figure_image_missile_launcher_offset(figure *f)
     }
 }
 
-int figure_image_direction(figure *f)
+int figure_image_direction(const figure *f)
 {
     int dir = f->direction - city_view_orientation();
     if (dir < 0) {
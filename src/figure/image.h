@@ -3,8 +3,21 @@
 
 #include "figure/figure.h"
 
+/**
+ * Sets the figure to use its standard walking or corpse image from the given base.
+ * The image is only worked out when it is needed, see figure_image_get
+ * @param f Figure
+ * @param image_base First image of the figure's image group
+ */
 void figure_image_update(figure *f, int image_base);
 
+/**
+ * Returns the image to draw or save for the figure
+ * @param f Figure
+ * @return Image id
+ */
+unsigned int figure_image_get(const figure *f);
+
 void figure_image_increase_offset(figure *f, int max);
 
 void figure_image_set_cart_offset(figure *f, int direction);
@@ -13,7 +26,7 @@ int figure_image_corpse_offset(figure *f);
 
 int figure_image_missile_launcher_offset(figure *f);
 
-int figure_image_direction(figure *f);
+int figure_image_direction(const figure *f);
 
 int figure_image_normalize_direction(int direction);
 
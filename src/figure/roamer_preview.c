@@ -10,17 +10,60 @@
 #include "map/building.h"
 #include "map/grid.h"
 #include "map/road_access.h"
+#include "map/road_network.h"
 
+#include <stdlib.h>
 #include <string.h>
 
 #define TOTAL_ROAMERS 4
 #define MAX_STORED_BUILDING_TYPES 2
 #define SHOWN_BUILDING_OFFSET 12
+#define PREVIEW_CACHE_SIZE 256
+#define MAX_PENDING_PREVIEWS 1000
+#define MAX_PREVIEWS_PER_FRAME 8
+#define STEPS_SIZE_STEP 256
+
+#define STEP_TYPE_BITS 2
+#define STEP_TYPE_MASK ((1 << STEP_TYPE_BITS) - 1)
+
+enum {
+    STEP_PASS = 0,
+    STEP_EXIT = 1,
+    STEP_ENTRY = 2
+};
+
+// The tiles the simulated roamers of a building walked on, in order,
+// so the walk can be replayed without simulating it again
+typedef struct {
+    int in_use;
+    building_type type;
+    int x;
+    int y;
+    int orientation;
+    int road_network_revision;
+    int disallow_diagonal;
+    int *steps;
+    int num_steps;
+    int steps_capacity;
+} cached_preview;
+
+typedef struct {
+    building_type type;
+    int x;
+    int y;
+} pending_preview;
 
 static struct {
     grid_u8 travelled_tiles;
     building_type types[MAX_STORED_BUILDING_TYPES];
     int stored_building_types;
+    cached_preview cache[PREVIEW_CACHE_SIZE];
+    cached_preview *recording;
+    struct {
+        pending_preview items[MAX_PENDING_PREVIEWS];
+        int current;
+        int total;
+    } pending;
 } data;
 
 static figure_type building_type_to_figure_type(building_type type)
@@ -201,30 +244,77 @@ static int determine_road_access(int x, int y, int size, building_type type, map
     }
 }
 
-void figure_roamer_preview_create(building_type b_type, int x, int y)
+static void apply_step(int step)
 {
-    if (!config_get(CONFIG_UI_SHOW_ROAMING_PATH)) {
-        figure_roamer_preview_reset_building_types();
-        return;
+    int grid_offset = step >> STEP_TYPE_BITS;
+    switch (step & STEP_TYPE_MASK) {
+        case STEP_PASS:
+            if (data.travelled_tiles.items[grid_offset] < FIGURE_ROAMER_PREVIEW_MAX_PASSAGES) {
+                data.travelled_tiles.items[grid_offset]++;
+            }
+            break;
+        case STEP_EXIT:
+            data.travelled_tiles.items[grid_offset] = FIGURE_ROAMER_PREVIEW_EXIT_TILE;
+            break;
+        case STEP_ENTRY:
+            data.travelled_tiles.items[grid_offset] =
+                data.travelled_tiles.items[grid_offset] < FIGURE_ROAMER_PREVIEW_EXIT_TILE ?
+                FIGURE_ROAMER_PREVIEW_ENTRY_TILE : FIGURE_ROAMER_PREVIEW_ENTRY_EXIT_TILE;
+            break;
     }
+}
 
-    figure_type fig_type = building_type_to_figure_type(b_type);
-    if (fig_type == FIGURE_NONE) {
+static void add_step(int type, int grid_offset)
+{
+    int step = (grid_offset << STEP_TYPE_BITS) | type;
+    apply_step(step);
+    cached_preview *preview = data.recording;
+    if (!preview) {
         return;
     }
-
-    if (fig_type == FIGURE_LABOR_SEEKER && config_get(CONFIG_GP_CH_GLOBAL_LABOUR)) {
-        return;
+    if (preview->num_steps == preview->steps_capacity) {
+        int new_capacity = preview->steps_capacity ? preview->steps_capacity * 2 : STEPS_SIZE_STEP;
+        int *new_steps = realloc(preview->steps, new_capacity * sizeof(int));
+        if (!new_steps) {
+            // Keep showing the walk, just don't cache it
+            preview->in_use = 0;
+            data.recording = 0;
+            return;
+        }
+        preview->steps = new_steps;
+        preview->steps_capacity = new_capacity;
     }
+    preview->steps[preview->num_steps++] = step;
+}
 
-    int grid_offset = map_grid_offset(x, y);
-
-    if (data.travelled_tiles.items[grid_offset] == SHOWN_BUILDING_OFFSET) {
-        return;
+static int get_building_orientation(building_type type)
+{
+    if (type == BUILDING_WAREHOUSE || type == BUILDING_HIPPODROME) {
+        return building_rotation_get_building_orientation(building_rotation_get_rotation());
     }
+    return 0;
+}
 
-    data.travelled_tiles.items[grid_offset] = SHOWN_BUILDING_OFFSET;
+static cached_preview *get_cached_preview(building_type type, int x, int y, int *is_valid)
+{
+    unsigned int hash = ((unsigned int) type * 31 + x) * 163 + y;
+    cached_preview *preview = &data.cache[hash % PREVIEW_CACHE_SIZE];
+    *is_valid = preview->in_use && preview->type == type && preview->x == x && preview->y == y &&
+        preview->orientation == get_building_orientation(type) &&
+        preview->road_network_revision == map_road_network_revision() &&
+        preview->disallow_diagonal == config_get(CONFIG_GP_CH_ROAMERS_DONT_SKIP_CORNERS);
+    return preview;
+}
+
+static int is_cached(building_type type, int x, int y)
+{
+    int is_valid;
+    get_cached_preview(type, x, y, &is_valid);
+    return is_valid;
+}
 
+static void simulate_roamers(building_type b_type, figure_type fig_type, int x, int y)
+{
     int b_size = building_is_farm(b_type) ? 3 : building_properties_for_type(b_type)->size;
 
     map_point road;
@@ -267,12 +357,12 @@ void figure_roamer_preview_create(building_type b_type, int x, int y)
         }
         roamer.grid_offset = map_grid_offset(roamer.x, roamer.y);
         if (map_grid_is_valid_offset(roamer.grid_offset)) {
-            data.travelled_tiles.items[roamer.grid_offset] = FIGURE_ROAMER_PREVIEW_EXIT_TILE;
+            add_step(STEP_EXIT, roamer.grid_offset);
         }
         init_roaming(&roamer, i * 2, roamer.x, roamer.y);
         while (++roamer.roam_length < roamer.max_roam_length) {
-            if (roamer.progress_on_tile == 0 && data.travelled_tiles.items[roamer.grid_offset] < FIGURE_ROAMER_PREVIEW_MAX_PASSAGES) {
-                data.travelled_tiles.items[roamer.grid_offset]++;
+            if (roamer.progress_on_tile == 0) {
+                add_step(STEP_PASS, roamer.grid_offset);
             }
             figure_movement_roam_ticks(&roamer, 1);
         }
@@ -286,21 +376,104 @@ void figure_roamer_preview_create(building_type b_type, int x, int y)
         roamer.destination_y = y_road;
         while (roamer.direction != DIR_FIGURE_AT_DESTINATION &&
             roamer.direction != DIR_FIGURE_REROUTE && roamer.direction != DIR_FIGURE_LOST) {
-            if (data.travelled_tiles.items[roamer.grid_offset] < FIGURE_ROAMER_PREVIEW_MAX_PASSAGES) {
-                data.travelled_tiles.items[roamer.grid_offset]++;
-            }
+            add_step(STEP_PASS, roamer.grid_offset);
             roamer.progress_on_tile = 15;
             figure_movement_move_ticks(&roamer, 1);
         }
         figure_route_remove(&roamer);
         if (roamer.direction == DIR_FIGURE_AT_DESTINATION) {
-            int tile_type = data.travelled_tiles.items[roamer.grid_offset];
-            data.travelled_tiles.items[roamer.grid_offset] = tile_type < FIGURE_ROAMER_PREVIEW_EXIT_TILE ?
-                FIGURE_ROAMER_PREVIEW_ENTRY_TILE : FIGURE_ROAMER_PREVIEW_ENTRY_EXIT_TILE;
+            add_step(STEP_ENTRY, roamer.grid_offset);
         }
     }
 }
 
+static figure_type get_previewed_figure_type(building_type b_type)
+{
+    figure_type fig_type = building_type_to_figure_type(b_type);
+    if (fig_type == FIGURE_LABOR_SEEKER && config_get(CONFIG_GP_CH_GLOBAL_LABOUR)) {
+        return FIGURE_NONE;
+    }
+    return fig_type;
+}
+
+void figure_roamer_preview_create(building_type b_type, int x, int y)
+{
+    if (!config_get(CONFIG_UI_SHOW_ROAMING_PATH)) {
+        figure_roamer_preview_reset_building_types();
+        return;
+    }
+
+    figure_type fig_type = get_previewed_figure_type(b_type);
+    if (fig_type == FIGURE_NONE) {
+        return;
+    }
+
+    int grid_offset = map_grid_offset(x, y);
+
+    if (data.travelled_tiles.items[grid_offset] == SHOWN_BUILDING_OFFSET) {
+        return;
+    }
+
+    data.travelled_tiles.items[grid_offset] = SHOWN_BUILDING_OFFSET;
+
+    int is_valid;
+    cached_preview *preview = get_cached_preview(b_type, x, y, &is_valid);
+    if (is_valid) {
+        for (int i = 0; i < preview->num_steps; i++) {
+            apply_step(preview->steps[i]);
+        }
+        return;
+    }
+
+    preview->in_use = 1;
+    preview->type = b_type;
+    preview->x = x;
+    preview->y = y;
+    preview->orientation = get_building_orientation(b_type);
+    preview->road_network_revision = map_road_network_revision();
+    preview->disallow_diagonal = config_get(CONFIG_GP_CH_ROAMERS_DONT_SKIP_CORNERS);
+    preview->num_steps = 0;
+    data.recording = preview;
+    simulate_roamers(b_type, fig_type, x, y);
+    data.recording = 0;
+}
+
+static void queue_preview(building_type type, int x, int y)
+{
+    if (is_cached(type, x, y) || data.pending.total >= MAX_PENDING_PREVIEWS) {
+        figure_roamer_preview_create(type, x, y);
+        return;
+    }
+    data.pending.items[data.pending.total].type = type;
+    data.pending.items[data.pending.total].x = x;
+    data.pending.items[data.pending.total].y = y;
+    data.pending.total++;
+}
+
+void figure_roamer_preview_process_pending(void)
+{
+    int processed = 0;
+    while (data.pending.current < data.pending.total && processed < MAX_PREVIEWS_PER_FRAME) {
+        const pending_preview *pending = &data.pending.items[data.pending.current++];
+        if (!is_cached(pending->type, pending->x, pending->y)) {
+            processed++;
+        }
+        figure_roamer_preview_create(pending->type, pending->x, pending->y);
+    }
+    if (data.pending.current == data.pending.total) {
+        data.pending.current = 0;
+        data.pending.total = 0;
+    }
+}
+
+void figure_roamer_preview_clear_cache(void)
+{
+    for (int i = 0; i < PREVIEW_CACHE_SIZE; i++) {
+        free(data.cache[i].steps);
+    }
+    memset(data.cache, 0, sizeof(data.cache));
+}
+
 void figure_roamer_preview_create_all_for_building_type(building_type type)
 {
     if (type == BUILDING_NONE) {
@@ -319,7 +492,7 @@ void figure_roamer_preview_create_all_for_building_type(building_type type)
         return;
     }
     for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
-        figure_roamer_preview_create(type, b->x, b->y);
+        queue_preview(type, b->x, b->y);
     }
     data.types[data.stored_building_types] = type;
     data.stored_building_types++;
@@ -328,11 +501,10 @@ void figure_roamer_preview_create_all_for_building_type(building_type type)
 void figure_roamer_preview_reset(building_type type)
 {
     map_grid_clear_u8(data.travelled_tiles.items);
+    data.pending.current = 0;
+    data.pending.total = 0;
     int show_other_roamers = 0;
-    figure_type fig_type = building_type_to_figure_type(type);
-    if (fig_type == FIGURE_LABOR_SEEKER && config_get(CONFIG_GP_CH_GLOBAL_LABOUR)) {
-        fig_type = FIGURE_NONE;
-    }
+    figure_type fig_type = get_previewed_figure_type(type);
     if (fig_type == FIGURE_NONE) {
         show_other_roamers = 1;
     } else {
@@ -346,7 +518,7 @@ void figure_roamer_preview_reset(building_type type)
     if (show_other_roamers) {
         for (int i = 0; i < data.stored_building_types; i++) {
             for (building *b = building_first_of_type(data.types[i]); b; b = b->next_of_type) {
-                figure_roamer_preview_create(b->type, b->x, b->y);
+                queue_preview(b->type, b->x, b->y);
             }
         }
     }
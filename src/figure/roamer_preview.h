@@ -15,4 +15,15 @@ void figure_roamer_preview_reset(building_type type);
 void figure_roamer_preview_reset_building_types(void);
 int figure_roamer_preview_get_frequency(int grid_offset);
 
+/**
+ * Simulates some of the roamer walks that were not cached yet when the previews were requested.
+ * Should be called once per frame so the previews of a whole city are built up over a few frames.
+ */
+void figure_roamer_preview_process_pending(void);
+
+/**
+ * Discards all cached roamer walks
+ */
+void figure_roamer_preview_clear_cache(void);
+
 #endif // FIGURE_ROAMER_PREVIEW_H
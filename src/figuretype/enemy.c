@@ -695,15 +695,15 @@ void figure_enemy_catapult_action(figure *f)
     int dir = get_missile_direction(f, m);
 
     if (f->action_state == FIGURE_ACTION_149_CORPSE) {
-        f->image_id = assets_get_image_id("Warriors", "catapult_death_01") + figure_image_corpse_offset(f);
+        f->image_id = assets_lookup_image_id(ASSET_FIGURE_CATAPULT_DEATH) + figure_image_corpse_offset(f);
     } else if (f->direction == DIR_FIGURE_ATTACK) {
-        f->image_id = assets_get_image_id("Warriors", "catapult_ne_01") + dir;
+        f->image_id = assets_lookup_image_id(ASSET_FIGURE_CATAPULT) + dir;
     } else if (f->action_state == FIGURE_ACTION_150_ATTACK) {
-        f->image_id = assets_get_image_id("Warriors", "catapult_ne_01") + dir;
+        f->image_id = assets_lookup_image_id(ASSET_FIGURE_CATAPULT) + dir;
     } else if (f->action_state == FIGURE_ACTION_151_ENEMY_INITIAL) {
-        f->image_id = assets_get_image_id("Warriors", "catapult_fe_e_01") + dir * 8 + figure_image_missile_launcher_offset(f);
+        f->image_id = assets_lookup_image_id(ASSET_FIGURE_CATAPULT_FIRE) + dir * 8 + figure_image_missile_launcher_offset(f);
     } else {
-        f->image_id = assets_get_image_id("Warriors", "catapult_ne_01") + dir;
+        f->image_id = assets_lookup_image_id(ASSET_FIGURE_CATAPULT) + dir;
     }
 
 }
@@ -238,10 +238,10 @@ void figure_tavern_action(figure *f)
     roamer_action(f, 1);
     int dir = figure_image_normalize_direction(f->direction < 8 ? f->direction : f->previous_tile_direction);
     if (f->action_state == FIGURE_ACTION_149_CORPSE) {
-        f->image_id = assets_get_image_id("Walkers", "Barkeep Death 01") +
+        f->image_id = assets_lookup_image_id(ASSET_FIGURE_BARKEEP_DEATH) +
             figure_image_corpse_offset(f);
     } else {
-        f->image_id = assets_get_image_id("Walkers", "Barkeep NE 01") + dir * 12 +
+        f->image_id = assets_lookup_image_id(ASSET_FIGURE_BARKEEP) + dir * 12 +
             f->image_offset;
     }
 }
@@ -395,7 +395,7 @@ void figure_doctor_action(figure *f)
             if (f->image_offset >= sizeof DOCTOR_HEALING_OFFSETS / sizeof DOCTOR_HEALING_OFFSETS[0]) {
                 f->image_offset = 0;
             }
-            f->image_id = assets_get_image_id("Health_Culture", "Doctor heal") +
+            f->image_id = assets_lookup_image_id(ASSET_FIGURE_DOCTOR_HEAL) +
                 DOCTOR_HEALING_OFFSETS[f->image_offset];
             break;
     }
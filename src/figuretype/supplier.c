@@ -281,17 +281,17 @@ void figure_supplier_action(figure *f)
         switch (f->action_state) {
             case FIGURE_ACTION_150_ATTACK:
                 if (f->attack_image_offset < 14) {
-                    f->image_id = assets_get_image_id("Walkers", "quartermaster_f_ne_01") + dir * 6;
+                    f->image_id = assets_lookup_image_id(ASSET_FIGURE_QUARTERMASTER_FIGHT) + dir * 6;
                 } else {
-                    f->image_id = assets_get_image_id("Walkers", "quartermaster_f_ne_01") + dir * 6 + ((f->attack_image_offset - 14) / 2);
+                    f->image_id = assets_lookup_image_id(ASSET_FIGURE_QUARTERMASTER_FIGHT) + dir * 6 + ((f->attack_image_offset - 14) / 2);
                 }
                 break;
             case FIGURE_ACTION_149_CORPSE:
-                f->image_id = assets_get_image_id("Walkers", "quartermaster_death_01") +
+                f->image_id = assets_lookup_image_id(ASSET_FIGURE_QUARTERMASTER_DEATH) +
                     figure_image_corpse_offset(f);
                 break;
             default:
-                f->image_id = assets_get_image_id("Walkers", "quartermaster_ne_01") +
+                f->image_id = assets_lookup_image_id(ASSET_FIGURE_QUARTERMASTER) +
                     dir * 12 + f->image_offset;
                 break;
         }
@@ -300,10 +300,10 @@ void figure_supplier_action(figure *f)
     } else if (f->type == FIGURE_BARKEEP_SUPPLIER) {
         int dir = figure_image_normalize_direction(f->direction < 8 ? f->direction : f->previous_tile_direction);
         if (f->action_state == FIGURE_ACTION_149_CORPSE) {
-            f->image_id = assets_get_image_id("Walkers", "Barkeep Death 01") +
+            f->image_id = assets_lookup_image_id(ASSET_FIGURE_BARKEEP_DEATH) +
                 figure_image_corpse_offset(f);
         } else {
-            f->image_id = assets_get_image_id("Walkers", "Barkeep NE 01") +
+            f->image_id = assets_lookup_image_id(ASSET_FIGURE_BARKEEP) +
                 dir * 12 + f->image_offset;
         }
     } else if (f->type == FIGURE_LIGHTHOUSE_SUPPLIER) {
@@ -326,19 +326,19 @@ void figure_supplier_action(figure *f)
     } else if (f->type == FIGURE_CARAVANSERAI_SUPPLIER) {
         int dir = figure_image_normalize_direction(f->direction < 8 ? f->direction : f->previous_tile_direction);
         if (f->action_state == FIGURE_ACTION_149_CORPSE) {
-            f->image_id = assets_get_image_id("Walkers", "caravanserai_overseer_death_01") +
+            f->image_id = assets_lookup_image_id(ASSET_FIGURE_CARAVANSERAI_OVERSEER_DEATH) +
                 figure_image_corpse_offset(f);
         } else {
-            f->image_id = assets_get_image_id("Walkers", "caravanserai_overseer_ne_01") +
+            f->image_id = assets_lookup_image_id(ASSET_FIGURE_CARAVANSERAI_OVERSEER) +
                 dir * 12 + f->image_offset;
         }
     } else {
         int dir = figure_image_normalize_direction(f->direction < 8 ? f->direction : f->previous_tile_direction);
         if (f->action_state == FIGURE_ACTION_149_CORPSE) {
-            f->image_id = assets_get_image_id("Walkers", "marketbuyer_death_01") +
+            f->image_id = assets_lookup_image_id(ASSET_FIGURE_MARKET_BUYER_DEATH) +
                 figure_image_corpse_offset(f);
         } else {
-            f->image_id = assets_get_image_id("Walkers", "marketbuyer_ne_01") +
+            f->image_id = assets_lookup_image_id(ASSET_FIGURE_MARKET_BUYER) +
                 dir * 12 + f->image_offset;
         }
     }
@@ -377,17 +377,17 @@ void figure_delivery_boy_action(figure *f)
 
     if (f->type == FIGURE_MESS_HALL_COLLECTOR) {
         if (f->action_state == FIGURE_ACTION_149_CORPSE) {
-            f->image_id = assets_get_image_id("Walkers", "M Hall death 01") +
+            f->image_id = assets_lookup_image_id(ASSET_FIGURE_MESS_HALL_BUYER_DEATH) +
                 figure_image_corpse_offset(f);
         } else {
-            f->image_id = assets_get_image_id("Walkers", "M Hall NE 01") +
+            f->image_id = assets_lookup_image_id(ASSET_FIGURE_MESS_HALL_BUYER) +
                 dir * 12 + f->image_offset;
         }
     } else if (f->type == FIGURE_CARAVANSERAI_COLLECTOR) {
         if (f->action_state == FIGURE_ACTION_149_CORPSE) {
-            f->image_id = assets_get_image_id("Walkers", "caravanserai_walker_death_01") + figure_image_corpse_offset(f);
+            f->image_id = assets_lookup_image_id(ASSET_FIGURE_CARAVANSERAI_WALKER_DEATH) + figure_image_corpse_offset(f);
         } else {
-            f->image_id = assets_get_image_id("Walkers", "caravanserai_walker_ne_01")
+            f->image_id = assets_lookup_image_id(ASSET_FIGURE_CARAVANSERAI_WALKER)
                 + dir * 12 + f->image_offset;
         }
     } else {
@@ -448,10 +448,10 @@ void figure_fort_supplier_action(figure *f)
 
     int dir = figure_image_normalize_direction(f->direction < 8 ? f->direction : f->previous_tile_direction);
     if (f->action_state == FIGURE_ACTION_149_CORPSE) {
-        f->image_id = assets_get_image_id("Walkers", "M Hall death 01") +
+        f->image_id = assets_lookup_image_id(ASSET_FIGURE_MESS_HALL_BUYER_DEATH) +
             figure_image_corpse_offset(f);
     } else {
-        f->image_id = assets_get_image_id("Walkers", "M Hall NE 01") +
+        f->image_id = assets_lookup_image_id(ASSET_FIGURE_MESS_HALL_BUYER) +
             dir * 12 + f->image_offset;
     }
 }
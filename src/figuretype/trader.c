@@ -17,6 +17,7 @@
 #include "city/resource.h"
 #include "city/trade.h"
 #include "city/trade_policy.h"
+#include "core/array.h"
 #include "core/calc.h"
 #include "core/config.h"
 #include "core/image.h"
@@ -40,6 +41,22 @@
 
 #define INFINITE 10000
 #define TRADER_INITIAL_WAIT GAME_TIME_TICKS_PER_DAY
+#define TRADE_CANDIDATES_SIZE_STEP 64
+
+typedef struct {
+    int building_id;
+    int had_plague;
+    unsigned int accepted_resources;
+} trade_candidate;
+
+// Warehouses and granaries in the order traders evaluate them, with the resources each one accepts.
+// Checking acceptance walks the warehouse spaces several times per resource, so the table is only
+// refreshed when stored goods or storage settings change instead of for every trader decision.
+static struct {
+    array(trade_candidate) items;
+    int revision;
+    int is_valid;
+} trade_candidates;
 
 // Mercury Grand Temple base bonus to trader speed
 static int trader_bonus_speed(void)
@@ -321,9 +338,64 @@ static int trader_get_sell_resource(int building_id, int city_id)
     return 0;
 }
 
+static unsigned int get_accepted_resources(building *b)
+{
+    unsigned int accepted = 0;
+    for (int r = RESOURCE_MIN; r < RESOURCE_MAX; r++) {
+        int is_not_accepting = b->type == BUILDING_GRANARY ?
+            building_granary_is_not_accepting(r, b) : building_warehouse_is_not_accepting(r, b);
+        if (!is_not_accepting) {
+            accepted |= 1u << r;
+        }
+    }
+    return accepted;
+}
+
+static void add_trade_candidates(building_type type)
+{
+    for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
+        trade_candidate *candidate = array_advance(trade_candidates.items);
+        if (!candidate) {
+            trade_candidates.is_valid = 0;
+            return;
+        }
+        candidate->building_id = b->id;
+        candidate->had_plague = b->has_plague;
+        candidate->accepted_resources = get_accepted_resources(b);
+    }
+}
+
+static void update_trade_candidates(void)
+{
+    int revision = building_storage_stock_revision();
+    if (trade_candidates.is_valid && trade_candidates.revision == revision) {
+        return;
+    }
+    if (!trade_candidates.items.blocks &&
+        !array_init(trade_candidates.items, TRADE_CANDIDATES_SIZE_STEP, 0, 0)) {
+        return;
+    }
+    trade_candidates.items.size = 0;
+    trade_candidates.is_valid = 1;
+    trade_candidates.revision = revision;
+    add_trade_candidates(BUILDING_WAREHOUSE);
+    add_trade_candidates(BUILDING_GRANARY);
+}
+
+static unsigned int candidate_accepted_resources(trade_candidate *candidate, building *b)
+{
+    // Plague makes storages refuse everything without changing the stock revision
+    if (candidate->had_plague != b->has_plague) {
+        candidate->had_plague = b->has_plague;
+        candidate->accepted_resources = get_accepted_resources(b);
+    }
+    return candidate->accepted_resources;
+}
+
 static int get_closest_storage(const figure *f, int x, int y, int city_id, map_point *dst)
 {
     int can_import = 0;
+    unsigned int city_imports = 0;
     int exportable[RESOURCE_MAX];
     int importable[RESOURCE_MAX];
     exportable[RESOURCE_NONE] = 0;
@@ -342,22 +414,27 @@ static int get_closest_storage(const figure *f, int x, int y, int city_id, map_p
             importable[r] = 0;
         }
         can_import |= importable[r];
+        if (empire_can_import_resource_from_city(city_id, r)) {
+            city_imports |= 1u << r;
+        }
     }
+    update_trade_candidates();
     int min_distance = INFINITE;
     building *min_building = 0;
-    for (building *b = building_first_of_type(BUILDING_WAREHOUSE); b; b = b->next_of_type) {
+    for (unsigned int i = 0; i < trade_candidates.items.size; i++) {
+        trade_candidate *candidate = array_item(trade_candidates.items, i);
+        building *b = building_get(candidate->building_id);
+        if (b->type != BUILDING_WAREHOUSE) {
+            continue;
+        }
         if (b->state != BUILDING_STATE_IN_USE || b->has_plague || !b->has_road_access || b->distance_from_entry <= 0 ||
             !building_storage_get_permission(BUILDING_STORAGE_PERMISSION_TRADERS, b)) {
             continue;
         }
         const building_storage *s = building_storage_get(b->storage_id);
         int distance_penalty = 32;
-        int num_imports_for_warehouse = 0;
-        for (int r = RESOURCE_MIN; r < RESOURCE_MAX; r++) {
-            if (!building_warehouse_is_not_accepting(r, b) && empire_can_import_resource_from_city(city_id, r)) {
-                num_imports_for_warehouse++;
-            }
-        }
+        unsigned int accepted = candidate_accepted_resources(candidate, b);
+        int num_imports_for_warehouse = (accepted & city_imports) != 0;
         building *space = b;
         for (int space_cnt = 0; space_cnt < 8; space_cnt++) {
             space = building_next(space);
@@ -366,12 +443,12 @@ static int get_closest_storage(const figure *f, int x, int y, int city_id, map_p
             }
             if (can_import && num_imports_for_warehouse && !s->empty_all) {
                 for (int r = RESOURCE_MIN; r < RESOURCE_MAX; r++) {
-                    if (!building_warehouse_is_not_accepting(city_trade_next_caravan_import_resource(), b)) {
+                    if (accepted & (1u << city_trade_next_caravan_import_resource())) {
                         break;
                     }
                 }
                 int resource = city_trade_current_caravan_import_resource();
-                if (!building_warehouse_is_not_accepting(resource, b)) {
+                if (accepted & (1u << resource)) {
                     if (space->subtype.warehouse_resource_id == RESOURCE_NONE) {
                         distance_penalty -= 16;
                     }
@@ -391,7 +468,12 @@ static int get_closest_storage(const figure *f, int x, int y, int city_id, map_p
             }
         }
     }
-    for (building *b = building_first_of_type(BUILDING_GRANARY); b; b = b->next_of_type) {
+    for (unsigned int i = 0; i < trade_candidates.items.size; i++) {
+        trade_candidate *candidate = array_item(trade_candidates.items, i);
+        building *b = building_get(candidate->building_id);
+        if (b->type != BUILDING_GRANARY) {
+            continue;
+        }
         if (b->state != BUILDING_STATE_IN_USE || b->has_plague || !b->has_road_access || b->distance_from_entry <= 0 ||
             !building_storage_get_permission(BUILDING_STORAGE_PERMISSION_TRADERS, b)) {
             continue;
@@ -399,6 +481,7 @@ static int get_closest_storage(const figure *f, int x, int y, int city_id, map_p
 
         const building_storage *s = building_storage_get(b->storage_id);
         int distance_penalty = 32;
+        unsigned int accepted = candidate_accepted_resources(candidate, b);
         for (int r = RESOURCE_MIN; r < RESOURCE_MAX; r++) {
             int resource = city_trade_next_caravan_import_resource();
             if (!resource_is_food(resource)) {
@@ -409,7 +492,7 @@ static int get_closest_storage(const figure *f, int x, int y, int city_id, map_p
                 distance_penalty--;
             }
             if (!can_import || s->empty_all || !importable[resource] ||
-                building_granary_is_full(b) || building_granary_is_not_accepting(resource, b) ||
+                building_granary_is_full(b) || !(accepted & (1u << resource)) ||
                 !empire_can_import_resource_from_city(city_id, resource)) {
                 continue;
             }
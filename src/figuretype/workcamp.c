@@ -84,10 +84,10 @@ static void workcamp_worker_image_update(figure *f)
 {
     int dir = figure_image_normalize_direction(f->direction < 8 ? f->direction : f->previous_tile_direction);
     if (f->action_state == FIGURE_ACTION_149_CORPSE) {
-        f->image_id = assets_get_image_id("Walkers", "overseer_death_01") +
+        f->image_id = assets_lookup_image_id(ASSET_FIGURE_OVERSEER_DEATH) +
             figure_image_corpse_offset(f);
     } else {
-        f->image_id = assets_get_image_id("Walkers", "overseer_ne_01") + dir * 12 + f->image_offset;
+        f->image_id = assets_lookup_image_id(ASSET_FIGURE_OVERSEER) + dir * 12 + f->image_offset;
     }
 }
 
@@ -300,10 +300,10 @@ void figure_workcamp_slave_action(figure *f)
 
     int dir = figure_image_normalize_direction(f->direction < 8 ? f->direction : f->previous_tile_direction);
     if (f->action_state == FIGURE_ACTION_149_CORPSE) {
-        f->image_id = assets_get_image_id("Walkers", "Slave death 01") +
+        f->image_id = assets_lookup_image_id(ASSET_FIGURE_SLAVE_DEATH) +
             figure_image_corpse_offset(f);
     } else {
-        f->image_id = assets_get_image_id("Walkers", "Slave NE 01") + dir * 12 +
+        f->image_id = assets_lookup_image_id(ASSET_FIGURE_SLAVE) + dir * 12 +
             f->image_offset;
     }
 }
@@ -313,12 +313,12 @@ static void set_architect_graphic(figure *f, int working)
     int dir = figure_image_normalize_direction(f->direction < 8 ? f->direction : f->previous_tile_direction);
 
     if (f->action_state == FIGURE_ACTION_149_CORPSE) {
-        f->image_id = assets_get_image_id("Walkers", "architect_death_01") +
+        f->image_id = assets_lookup_image_id(ASSET_FIGURE_ARCHITECT_DEATH) +
             figure_image_corpse_offset(f);
     } else if (working) {
-        f->image_id = assets_get_image_id("Walkers", "Architect 01") + f->image_offset;
+        f->image_id = assets_lookup_image_id(ASSET_FIGURE_ARCHITECT_WORKING) + f->image_offset;
     } else {
-        f->image_id = assets_get_image_id("Walkers", "architect_ne_01") + dir * 12 +
+        f->image_id = assets_lookup_image_id(ASSET_FIGURE_ARCHITECT) + dir * 12 +
             f->image_offset;
     }
 }
@@ -4,7 +4,21 @@
 
 #include "zip/zip.h"
 
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
 #define CAMPAIGNS_PREFIX_SIZE sizeof(CAMPAIGNS_DIRECTORY)
+#define MIN_ENTRY_SLOTS 16
+#define MAX_CACHED_FILES 16
+#define MAX_CACHED_FILE_SIZE (4 * 1024 * 1024)
+#define MAX_CACHED_FILES_SIZE (16 * 1024 * 1024)
+
+typedef struct {
+    uint32_t hash;
+    int index;
+    char *name;
+} zip_entry_slot;
 
 static struct {
     int is_folder;
@@ -14,23 +28,188 @@ static struct {
         FILE *stream;
         struct zip_t *parser;
     } zip;
+    // Looking up an entry by name makes the zip library scan the whole central directory,
+    // so the names are hashed once when the campaign is first opened
+    struct {
+        zip_entry_slot *slots;
+        int size;
+    } entries;
+    // Small decompressed files such as sounds are requested many times while playing
+    struct {
+        struct {
+            int entry_index;
+            size_t length;
+            uint8_t *data;
+            unsigned int last_used;
+        } files[MAX_CACHED_FILES];
+        size_t total_size;
+        unsigned int use_counter;
+    } cache;
 } data;
 
+static char normalize_entry_char(char c)
+{
+    if (c == '\\') {
+        return '/';
+    }
+    return c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c;
+}
+
+static uint32_t hash_entry_name(const char *name)
+{
+    uint32_t hash = 2166136261u;
+    for (; *name; name++) {
+        hash = (hash ^ (uint8_t) normalize_entry_char(*name)) * 16777619u;
+    }
+    return hash;
+}
+
+static int entry_names_equal(const char *a, const char *b)
+{
+    for (; *a && *b; a++, b++) {
+        if (normalize_entry_char(*a) != normalize_entry_char(*b)) {
+            return 0;
+        }
+    }
+    return *a == *b;
+}
+
+static void clear_entry_index(void)
+{
+    for (int i = 0; i < data.entries.size; i++) {
+        free(data.entries.slots[i].name);
+    }
+    free(data.entries.slots);
+    data.entries.slots = 0;
+    data.entries.size = 0;
+}
+
+static void clear_file_cache(void)
+{
+    for (int i = 0; i < MAX_CACHED_FILES; i++) {
+        free(data.cache.files[i].data);
+    }
+    memset(&data.cache, 0, sizeof(data.cache));
+}
+
+static void build_entry_index(void)
+{
+    ssize_t total_entries = zip_entries_total(data.zip.parser);
+    if (total_entries < 0) {
+        return;
+    }
+    int size = MIN_ENTRY_SLOTS;
+    while (size < total_entries * 2) {
+        size *= 2;
+    }
+    data.entries.slots = calloc(size, sizeof(zip_entry_slot));
+    if (!data.entries.slots) {
+        return;
+    }
+    data.entries.size = size;
+    for (int i = 0; i < total_entries; i++) {
+        if (zip_entry_openbyindex(data.zip.parser, i) != 0) {
+            continue;
+        }
+        const char *name = zip_entry_name(data.zip.parser);
+        if (name) {
+            uint32_t hash = hash_entry_name(name);
+            int slot = hash & (size - 1);
+            while (data.entries.slots[slot].name) {
+                slot = (slot + 1) & (size - 1);
+            }
+            data.entries.slots[slot].name = malloc(strlen(name) + 1);
+            if (!data.entries.slots[slot].name) {
+                zip_entry_close(data.zip.parser);
+                clear_entry_index();
+                return;
+            }
+            strcpy(data.entries.slots[slot].name, name);
+            data.entries.slots[slot].hash = hash;
+            data.entries.slots[slot].index = i;
+        }
+        zip_entry_close(data.zip.parser);
+    }
+}
+
+static int open_entry(const char *name)
+{
+    if (!data.entries.slots) {
+        return zip_entry_open(data.zip.parser, name);
+    }
+    uint32_t hash = hash_entry_name(name);
+    for (int slot = hash & (data.entries.size - 1); data.entries.slots[slot].name;
+        slot = (slot + 1) & (data.entries.size - 1)) {
+        if (data.entries.slots[slot].hash == hash && entry_names_equal(data.entries.slots[slot].name, name)) {
+            return zip_entry_openbyindex(data.zip.parser, data.entries.slots[slot].index);
+        }
+    }
+    return -1;
+}
+
+static uint8_t *copy_cached_file(int entry_index, size_t *length)
+{
+    for (int i = 0; i < MAX_CACHED_FILES; i++) {
+        if (data.cache.files[i].data && data.cache.files[i].entry_index == entry_index) {
+            uint8_t *buffer = malloc(data.cache.files[i].length);
+            if (!buffer) {
+                return 0;
+            }
+            memcpy(buffer, data.cache.files[i].data, data.cache.files[i].length);
+            *length = data.cache.files[i].length;
+            data.cache.files[i].last_used = ++data.cache.use_counter;
+            return buffer;
+        }
+    }
+    return 0;
+}
+
+static void add_to_file_cache(int entry_index, const uint8_t *buffer, size_t length)
+{
+    if (length > MAX_CACHED_FILE_SIZE) {
+        return;
+    }
+    int slot;
+    do {
+        slot = -1;
+        int least_used = 0;
+        for (int i = 0; i < MAX_CACHED_FILES; i++) {
+            if (!data.cache.files[i].data) {
+                slot = i;
+            } else if (!data.cache.files[least_used].data ||
+                data.cache.files[i].last_used < data.cache.files[least_used].last_used) {
+                least_used = i;
+            }
+        }
+        if (slot == -1 || data.cache.total_size + length > MAX_CACHED_FILES_SIZE) {
+            data.cache.total_size -= data.cache.files[least_used].length;
+            free(data.cache.files[least_used].data);
+            memset(&data.cache.files[least_used], 0, sizeof(data.cache.files[least_used]));
+            slot = -1;
+        }
+    } while (slot == -1);
+    data.cache.files[slot].data = malloc(length);
+    if (!data.cache.files[slot].data) {
+        return;
+    }
+    memcpy(data.cache.files[slot].data, buffer, length);
+    data.cache.files[slot].entry_index = entry_index;
+    data.cache.files[slot].length = length;
+    data.cache.files[slot].last_used = ++data.cache.use_counter;
+    data.cache.total_size += length;
+}
+
 int campaign_file_exists(const char *filename)
 {
     if (data.is_folder) {
         snprintf(&data.file_name[data.file_name_offset], FILE_NAME_MAX - data.file_name_offset, "/%s", filename);
         return dir_get_file_at_location(data.file_name, PATH_LOCATION_CAMPAIGN) != 0;
     }
-    int close_at_end = data.zip.parser == 0;
     if (!campaign_file_open_zip()) {
         return 0;
     }
-    int has_file = zip_entry_open(data.zip.parser, filename) == 0;
+    int has_file = open_entry(filename) == 0;
     zip_entry_close(data.zip.parser);
-    if (close_at_end) {
-        campaign_file_close_zip();
-    }
     return has_file;
 }
 
@@ -66,40 +245,37 @@ static void *load_file_from_folder(const char *file, size_t *length)
 static void *load_file_from_zip(const char *file, size_t *length)
 {
     *length = 0;
-    int close_at_end = data.zip.parser == 0;
+    // The archive is kept open until the campaign changes, as campaigns keep requesting files
     if (!campaign_file_open_zip()) {
         return 0;
     }
-
-    if (zip_entry_open(data.zip.parser, file) < 0) {
-        if (close_at_end) {
-            campaign_file_close_zip();
-        }
+    if (open_entry(file) < 0) {
         return 0;
     }
+    int entry_index = (int) zip_entry_index(data.zip.parser);
+    uint8_t *buffer = copy_cached_file(entry_index, length);
+    if (buffer) {
+        zip_entry_close(data.zip.parser);
+        return buffer;
+    }
 
     *length = zip_entry_size(data.zip.parser);
-    uint8_t *buffer = malloc(*length);
+    buffer = malloc(*length);
     if (!buffer) {
         *length = 0;
         zip_entry_close(data.zip.parser);
-        if (close_at_end) {
-            campaign_file_close_zip();
-        }
         return 0;
     }
 
     size_t result = zip_entry_noallocread(data.zip.parser, buffer, *length);
     zip_entry_close(data.zip.parser);
-    if (close_at_end) {
-        campaign_file_close_zip();
-    }
 
     if (result != *length) {
         *length = 0;
         free(buffer);
         return 0;
     }
+    add_to_file_cache(entry_index, buffer, *length);
     return buffer;
 }
 
@@ -111,6 +287,8 @@ void *campaign_file_load(const char *file, size_t *length)
 void campaign_file_set_path(const char *path)
 {
     campaign_file_close_zip();
+    clear_entry_index();
+    clear_file_cache();
     if (path && path[0]) {
         data.is_folder = !file_has_extension(path, "campaign");
         data.file_name_offset = snprintf(data.file_name, FILE_NAME_MAX, "%s", path);
@@ -163,6 +341,9 @@ int campaign_file_open_zip(void)
             campaign_file_close_zip();
             return 0;
         }
+        if (!data.entries.slots) {
+            build_entry_index();
+        }
     }
     return 1;
 }
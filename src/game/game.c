@@ -24,6 +24,7 @@
 #include "game/tick.h"
 #include "graphics/font.h"
 #include "graphics/graphics.h"
+#include "graphics/screenshot.h"
 #include "graphics/text.h"
 #include "graphics/video.h"
 #include "graphics/window.h"
@@ -204,6 +205,10 @@ int game_reload_language(void)
 void game_run(void)
 {
     game_animation_update();
+    if (graphics_screenshot_in_progress()) {
+        // the city is frozen until the full city screenshot is done, even if the player unpauses
+        return;
+    }
     int num_ticks = game_speed_get_elapsed_ticks();
     for (int i = 0; i < num_ticks; i++) {
         game_tick_run();
@@ -217,6 +222,7 @@ void game_run(void)
 
 void game_draw(void)
 {
+    graphics_screenshot_update();
     window_draw(0);
     sound_city_play();
 }
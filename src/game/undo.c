@@ -14,6 +14,7 @@
 #include "city/finance.h"
 #include "core/calc.h"
 #include "core/image.h"
+#include "core/log.h"
 #include "figure/roamer_preview.h"
 #include "game/resource.h"
 #include "graphics/window.h"
@@ -28,9 +29,10 @@
 #include "map/terrain.h"
 #include "scenario/earthquake.h"
 
+#include <stdlib.h>
 #include <string.h>
 
-#define MAX_UNDO_BUILDINGS 50
+#define BUILDINGS_SIZE_STEP 50
 
 static struct {
     int available;
@@ -38,8 +40,9 @@ static struct {
     int timeout_ticks;
     int building_cost;
     int num_buildings;
+    int max_buildings;
     building_type type;
-    building buildings[MAX_UNDO_BUILDINGS];
+    building *buildings;
 } data;
 
 int game_can_undo(void)
@@ -52,6 +55,20 @@ void game_undo_disable(void)
     data.available = 0;
 }
 
+static int expand_buildings(void)
+{
+    int new_max_buildings = data.max_buildings + BUILDINGS_SIZE_STEP;
+    building *new_buildings = realloc(data.buildings, new_max_buildings * sizeof(building));
+    if (!new_buildings) {
+        log_error("Not enough memory to store the undo information", 0, 0);
+        return 0;
+    }
+    memset(&new_buildings[data.max_buildings], 0, BUILDINGS_SIZE_STEP * sizeof(building));
+    data.buildings = new_buildings;
+    data.max_buildings = new_max_buildings;
+    return 1;
+}
+
 void game_undo_add_building(building *b)
 {
     if (b->id <= 0) {
@@ -59,7 +76,7 @@ void game_undo_add_building(building *b)
     }
     data.num_buildings = 0;
     int is_on_list = 0;
-    for (int i = 0; i < MAX_UNDO_BUILDINGS; i++) {
+    for (int i = 0; i < data.max_buildings; i++) {
         if (data.buildings[i].id) {
             data.num_buildings++;
         }
@@ -68,20 +85,25 @@ void game_undo_add_building(building *b)
         }
     }
     if (!is_on_list) {
-        for (int i = 0; i < MAX_UNDO_BUILDINGS; i++) {
+        for (int i = 0; i < data.max_buildings; i++) {
             if (!data.buildings[i].id) {
                 data.num_buildings++;
                 memcpy(&data.buildings[i], b, sizeof(building));
                 return;
             }
         }
-        data.available = 0;
+        if (!expand_buildings()) {
+            data.available = 0;
+            return;
+        }
+        memcpy(&data.buildings[data.num_buildings], b, sizeof(building));
+        data.num_buildings++;
     }
 }
 
 void game_undo_adjust_building(building *b)
 {
-    for (int i = 0; i < MAX_UNDO_BUILDINGS; i++) {
+    for (int i = 0; i < data.max_buildings; i++) {
         if (data.buildings[i].id == b->id) {
             // found! update the building now
             memcpy(&data.buildings[i], b, sizeof(building));
@@ -97,7 +119,7 @@ int game_undo_contains_building(int building_id)
     if (data.num_buildings <= 0) {
         return 0;
     }
-    for (int i = 0; i < MAX_UNDO_BUILDINGS; i++) {
+    for (int i = 0; i < data.max_buildings; i++) {
         if (data.buildings[i].id == building_id) {
             return 1;
         }
@@ -108,7 +130,9 @@ int game_undo_contains_building(int building_id)
 static void clear_buildings(void)
 {
     data.num_buildings = 0;
-    memset(data.buildings, 0, MAX_UNDO_BUILDINGS * sizeof(building));
+    if (data.buildings) {
+        memset(data.buildings, 0, data.max_buildings * sizeof(building));
+    }
 }
 
 int game_undo_start_build(building_type type)
@@ -153,20 +177,6 @@ void game_undo_restore_building_state(void)
     clear_buildings();
 }
 
-static void restore_map_images(void)
-{
-    int map_width, map_height;
-    map_grid_size(&map_width, &map_height);
-    for (int y = 0; y < map_height; y++) {
-        for (int x = 0; x < map_width; x++) {
-            int grid_offset = map_grid_offset(x, y);
-            if (!map_building_at(grid_offset)) {
-                map_image_restore_at(grid_offset);
-            }
-        }
-    }
-}
-
 void game_undo_restore_map(int include_properties)
 {
     map_terrain_restore();
@@ -174,7 +184,7 @@ void game_undo_restore_map(int include_properties)
     if (include_properties) {
         map_property_restore();
     }
-    restore_map_images();
+    map_image_restore_except_buildings();
 }
 
 void game_undo_finish_build(int cost)
@@ -251,22 +261,22 @@ void game_undo_perform(void)
         data.type == BUILDING_WALL || data.type == BUILDING_HIGHWAY) {
         map_terrain_restore();
         map_aqueduct_restore();
-        restore_map_images();
+        map_image_restore_except_buildings();
     } else if (data.type == BUILDING_LOW_BRIDGE || data.type == BUILDING_SHIP_BRIDGE) {
         map_terrain_restore();
         map_sprite_restore();
-        restore_map_images();
+        map_image_restore_except_buildings();
     } else if (data.type == BUILDING_PLAZA || data.type == BUILDING_GARDENS ||
         data.type == BUILDING_OVERGROWN_GARDENS) {
         map_terrain_restore();
         map_aqueduct_restore();
         map_property_restore();
-        restore_map_images();
+        map_image_restore_except_buildings();
     } else if (data.num_buildings) {
         if (data.type == BUILDING_DRAGGABLE_RESERVOIR) {
             map_terrain_restore();
             map_aqueduct_restore();
-            restore_map_images();
+            map_image_restore_except_buildings();
         }
         for (int i = 0; i < data.num_buildings; i++) {
             if (data.buildings[i].id) {
@@ -22,12 +22,14 @@
 #define CLOUD_MIN_CREATION_TIMEOUT 200
 #define CLOUD_MAX_CREATION_TIMEOUT 2400
 
-#define CLOUD_ROWS 4
-#define CLOUD_COLUMNS 4
-#define NUM_CLOUDS (CLOUD_ROWS * CLOUD_COLUMNS)
+#define NUM_CLOUDS 16
 
-#define CLOUD_TEXTURE_WIDTH (CLOUD_WIDTH * CLOUD_COLUMNS)
-#define CLOUD_TEXTURE_HEIGHT (CLOUD_HEIGHT * CLOUD_ROWS)
+#define CLOUD_VARIANT_ROWS 4
+#define CLOUD_VARIANT_COLUMNS 8
+#define NUM_CLOUD_VARIANTS (CLOUD_VARIANT_ROWS * CLOUD_VARIANT_COLUMNS)
+
+#define CLOUD_TEXTURE_WIDTH (CLOUD_WIDTH * CLOUD_VARIANT_COLUMNS)
+#define CLOUD_TEXTURE_HEIGHT (CLOUD_HEIGHT * CLOUD_VARIANT_ROWS)
 
 #define CLOUD_SPEED 0.3
 
@@ -67,12 +69,20 @@ typedef struct {
     float scale_y;
     int side;
     int angle;
+    int variant;
 } cloud_type;
 
 static struct {
     cloud_type clouds[NUM_CLOUDS];
     int movement_timeout;
     int pause_frames;
+    // Cloud images are generated into a pool, one per frame, and respawning clouds
+    // pick one of the ready images instead of generating their own
+    struct {
+        int total_ready;
+        uint8_t darkened_alpha[256];
+        int darkened_alpha_ready;
+    } variants;
 } data;
 
 static int random_from_min_to_range(int min, int range)
@@ -107,23 +117,23 @@ static int ellipse_is_inside_bounds(const ellipse *e)
         y - e->height >= 0 && y + e->height < CLOUD_HEIGHT;
 }
 
-static void darken_pixel(color_t *cloud, int x, int y)
+static void init_darkened_alpha(void)
 {
-    int pixel = y * CLOUD_WIDTH + x;
-
-    color_t alpha = cloud[pixel] >> COLOR_BITSHIFT_ALPHA;
-    int darken = CLOUD_ALPHA_INCREASE >> (alpha >> 4);
-    alpha = (alpha + ((darken * (255 - alpha)) >> 8));
-
-    // Clamp
-    if (alpha > 255) {
-        alpha = 255;
+    for (int alpha = 0; alpha < 256; alpha++) {
+        int darken = CLOUD_ALPHA_INCREASE >> (alpha >> 4);
+        int darkened = alpha + ((darken * (255 - alpha)) >> 8);
+        data.variants.darkened_alpha[alpha] = darkened > 255 ? 255 : darkened;
     }
+    data.variants.darkened_alpha_ready = 1;
+}
 
-    cloud[pixel] = ALPHA_TRANSPARENT | (alpha << COLOR_BITSHIFT_ALPHA);
+static void darken_pixel(uint8_t *cloud, int x, int y)
+{
+    int pixel = y * CLOUD_WIDTH + x;
+    cloud[pixel] = data.variants.darkened_alpha[cloud[pixel]];
 }
 
-static void generate_cloud_ellipse(color_t *cloud, int width, int height)
+static void generate_cloud_ellipse(uint8_t *cloud, int width, int height)
 {
     ellipse e;
     do {
@@ -166,44 +176,86 @@ static void generate_cloud_ellipse(color_t *cloud, int width, int height)
 static void init_cloud_images(void)
 {
     graphics_renderer()->create_custom_image(CUSTOM_IMAGE_CLOUDS, CLOUD_TEXTURE_WIDTH, CLOUD_TEXTURE_HEIGHT, 0);
+    data.variants.total_ready = 0;
     for (int i = 0; i < NUM_CLOUDS; i++) {
         cloud_type *cloud = &data.clouds[i];
         image *img = &cloud->img;
         img->width = img->original.width = CLOUD_WIDTH;
         img->height = img->original.height = CLOUD_HEIGHT;
         img->atlas.id = (ATLAS_CUSTOM << IMAGE_ATLAS_BIT_OFFSET) | CUSTOM_IMAGE_CLOUDS;
-        img->atlas.x_offset = (i % CLOUD_COLUMNS) * CLOUD_WIDTH;
-        img->atlas.y_offset = (i / CLOUD_COLUMNS) * CLOUD_HEIGHT;
+        img->atlas.x_offset = 0;
+        img->atlas.y_offset = 0;
         cloud->x = 0;
         cloud->y = 0;
         cloud->side = 0;
         cloud->angle = 0;
+        cloud->variant = 0;
         cloud->status = STATUS_INACTIVE;
         speed_clear(&cloud->speed.x);
         speed_clear(&cloud->speed.y);
     }
 }
 
-static void generate_cloud(cloud_type *cloud)
+static void generate_next_cloud_variant(void)
 {
-    if (!graphics_renderer()->has_custom_image(CUSTOM_IMAGE_CLOUDS)) {
-        init_cloud_images();
+    if (!data.variants.darkened_alpha_ready) {
+        init_darkened_alpha();
     }
-
-    color_t pixels[CLOUD_WIDTH * CLOUD_HEIGHT];
-    memset(pixels, 0, sizeof(color_t) * CLOUD_WIDTH * CLOUD_HEIGHT);
+    uint8_t alpha[CLOUD_WIDTH * CLOUD_HEIGHT];
+    memset(alpha, 0, sizeof(alpha));
 
     int width = random_from_min_to_range((int) (CLOUD_WIDTH * 0.15f), (int) (CLOUD_WIDTH * 0.2f));
     int height = random_from_min_to_range((int) (CLOUD_HEIGHT * 0.15f), (int) (CLOUD_HEIGHT * 0.2f));
 
     for (int i = 0; i < NUM_CLOUD_ELLIPSES; i++) {
-        generate_cloud_ellipse(pixels, width, height);
+        generate_cloud_ellipse(alpha, width, height);
     }
 
-    const image *img = &cloud->img;
+    color_t pixels[CLOUD_WIDTH * CLOUD_HEIGHT];
+    for (int i = 0; i < CLOUD_WIDTH * CLOUD_HEIGHT; i++) {
+        pixels[i] = ALPHA_TRANSPARENT | ((color_t) alpha[i] << COLOR_BITSHIFT_ALPHA);
+    }
 
+    int variant = data.variants.total_ready;
     graphics_renderer()->update_custom_image_from(CUSTOM_IMAGE_CLOUDS, pixels,
-        img->atlas.x_offset, img->atlas.y_offset, img->width, img->height);
+        (variant % CLOUD_VARIANT_COLUMNS) * CLOUD_WIDTH, (variant / CLOUD_VARIANT_COLUMNS) * CLOUD_HEIGHT,
+        CLOUD_WIDTH, CLOUD_HEIGHT);
+    data.variants.total_ready++;
+}
+
+static int variant_in_use(int variant)
+{
+    for (int i = 0; i < NUM_CLOUDS; i++) {
+        if (data.clouds[i].status != STATUS_INACTIVE && data.clouds[i].variant == variant) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int pick_cloud_variant(void)
+{
+    int total = data.variants.total_ready;
+    int variant = random_between_from_stdlib(0, total);
+    for (int i = 0; i < total; i++) {
+        int candidate = (variant + i) % total;
+        if (!variant_in_use(candidate)) {
+            return candidate;
+        }
+    }
+    return variant;
+}
+
+static void spawn_cloud(cloud_type *cloud)
+{
+    if (!data.variants.total_ready) {
+        return;
+    }
+    cloud->variant = pick_cloud_variant();
+
+    image *img = &cloud->img;
+    img->atlas.x_offset = (cloud->variant % CLOUD_VARIANT_COLUMNS) * CLOUD_WIDTH;
+    img->atlas.y_offset = (cloud->variant / CLOUD_VARIANT_COLUMNS) * CLOUD_HEIGHT;
 
     cloud->x = 0;
     cloud->y = 0;
@@ -265,10 +317,17 @@ void clouds_draw(int x_offset, int y_offset, int x_limit, int y_limit, float bas
         cloud_speed = CLOUD_SPEED * setting_game_speed() / 100;
     }
 
+    if (!graphics_renderer()->has_custom_image(CUSTOM_IMAGE_CLOUDS)) {
+        init_cloud_images();
+    }
+    if (data.variants.total_ready < NUM_CLOUD_VARIANTS) {
+        generate_next_cloud_variant();
+    }
+
     for (int i = 0; i < NUM_CLOUDS; i++) {
         cloud_type *cloud = &data.clouds[i];
         if (cloud->status == STATUS_INACTIVE) {
-            generate_cloud(cloud);
+            spawn_cloud(cloud);
             continue;
         } else if (cloud->status == STATUS_CREATED) {
             if (data.movement_timeout > 0) {
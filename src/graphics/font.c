@@ -250,6 +250,7 @@ static struct {
     const int *font_mapping;
     const font_definition *font_definitions;
     int multibyte;
+    int revision;
 } data;
 
 static int image_y_offset_none(uint8_t c, int image_height, int line_height)
@@ -503,6 +504,7 @@ static int image_y_offset_japanese(uint8_t c, int image_height, int line_height)
 
 void font_set_encoding(encoding_type encoding)
 {
+    font_mark_changed();
     data.multibyte = MULTIBYTE_NONE;
     if (encoding == ENCODING_EASTERN_EUROPE) {
         data.font_mapping = CHAR_TO_FONT_IMAGE_EASTERN;
@@ -538,6 +540,16 @@ void font_set_encoding(encoding_type encoding)
     }
 }
 
+void font_mark_changed(void)
+{
+    data.revision++;
+}
+
+int font_revision(void)
+{
+    return data.revision;
+}
+
 const font_definition *font_definition_for(font_t font)
 {
     return &data.font_definitions[font];
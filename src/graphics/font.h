@@ -43,6 +43,17 @@ typedef struct {
  */
 void font_set_encoding(encoding_type encoding);
 
+/**
+ * Marks the fonts as changed, for example after the font images have been reloaded
+ */
+void font_mark_changed(void);
+
+/**
+ * Gets a counter that changes every time the encoding or the font images change
+ * @return Font revision
+ */
+int font_revision(void);
+
 /**
  * Gets the font definition for the specified font
  * @param font Font
@@ -3,10 +3,12 @@
 #include "city/view.h"
 #include "city/warning.h"
 #include "core/buffer.h"
+#include "core/calc.h"
 #include "core/config.h"
 #include "core/file.h"
 #include "core/log.h"
 #include "core/string.h"
+#include "game/state.h"
 #include "graphics/screen.h"
 #include "graphics/graphics.h"
 #include "graphics/menu.h"
@@ -30,6 +32,8 @@
 #define IMAGE_HEIGHT_CHUNK (TILE_Y_SIZE * 15)
 #define IMAGE_BYTES_PER_PIXEL 3
 #define MINIMAP_SCALE 2.0f
+#define MIN_CANVAS_WIDTH (TILE_X_SIZE * 8)
+#define MAX_SIDEBAR_WIDTH 162
 
 static struct {
     int width;
@@ -44,6 +48,23 @@ static struct {
     spng_ctx *ctx;
 } screenshot;
 
+// A full city screenshot is drawn one band of rows per frame, so the game keeps responding
+static struct {
+    int in_progress;
+    color_t *canvas;
+    char filename[FILE_NAME_MAX];
+    int canvas_width;
+    int chunk_height;
+    int city_width_pixels;
+    int min_width;
+    int max_height;
+    int current_height;
+    int current_row;
+    int total_rows;
+    int progress_warning_id;
+    int was_paused;
+} full_city;
+
 static void image_free(void)
 {
     screenshot.width = 0;
@@ -254,18 +275,68 @@ static void create_window_screenshot(void)
     image_free();
 }
 
+static void full_city_free(void)
+{
+    free(full_city.canvas);
+    full_city.canvas = 0;
+    if (full_city.in_progress) {
+        if (full_city.was_paused) {
+            game_state_pause();
+        } else {
+            game_state_unpause();
+        }
+    }
+    full_city.in_progress = 0;
+    if (full_city.progress_warning_id) {
+        city_warning_clear_id(full_city.progress_warning_id);
+        full_city.progress_warning_id = 0;
+    }
+    image_free();
+    window_invalidate();
+}
+
+static void full_city_abort(void)
+{
+    full_city_free();
+    // an incomplete image is of no use, so don't leave it behind
+    file_remove(full_city.filename);
+}
+
+static void show_full_city_progress(int current_row, int total_rows)
+{
+    uint8_t progress_text[FILE_NAME_MAX];
+    const uint8_t *prefix = translation_for(TR_WARNING_SCREENSHOT_IN_PROGRESS);
+    uint8_t *cursor = string_copy(prefix, progress_text, FILE_NAME_MAX - 8);
+    cursor += string_from_int(cursor, calc_percentage(current_row, total_rows), 0);
+    cursor[0] = '%';
+    cursor[1] = 0;
+    full_city.progress_warning_id = city_warning_show_custom(progress_text, full_city.progress_warning_id);
+}
+
+static int get_strip_size(int screen_size, int border, int tile_size, int min_size, int city_size)
+{
+    // Use the largest strip the screen can hold, but never less than the original fixed size
+    // and never wider than half the city, so the camera clamping at the map edges still applies
+    int size = (screen_size - border) / tile_size * tile_size;
+    if (size > city_size / 2) {
+        size = city_size / 2 / tile_size * tile_size;
+    }
+    return size < min_size ? min_size : size;
+}
+
 static void create_full_city_screenshot(void)
 {
     if (!window_is(WINDOW_CITY) && !window_is(WINDOW_CITY_MILITARY)) {
         return;
     }
-    pixel_offset original_camera_pixels;
-    city_view_get_camera_in_pixels(&original_camera_pixels.x, &original_camera_pixels.y);
-
-    int city_width_pixels = map_grid_width() * TILE_X_SIZE;
+    full_city.city_width_pixels = map_grid_width() * TILE_X_SIZE;
     int city_height_pixels = map_grid_height() * TILE_Y_SIZE;
+    full_city.canvas_width = get_strip_size(screen_width(), MAX_SIDEBAR_WIDTH, TILE_X_SIZE,
+        MIN_CANVAS_WIDTH, full_city.city_width_pixels);
+    full_city.chunk_height = get_strip_size(screen_height(), TOP_MENU_HEIGHT, TILE_Y_SIZE,
+        IMAGE_HEIGHT_CHUNK, city_height_pixels);
 
-    if (!image_create(city_width_pixels, city_height_pixels + TILE_Y_SIZE, 0, IMAGE_HEIGHT_CHUNK)) {
+    if (!image_create(full_city.city_width_pixels, city_height_pixels + TILE_Y_SIZE, 0, full_city.chunk_height)) {
         log_error("Unable to set memory for full city screenshot", 0, 0);
         return;
     }
@@ -275,66 +346,91 @@ static void create_full_city_screenshot(void)
         image_free();
         return;
     }
+    snprintf(full_city.filename, FILE_NAME_MAX, "%s", filename);
 
-    color_t *canvas = malloc(sizeof(color_t) * city_width_pixels * IMAGE_HEIGHT_CHUNK);
-    if (!canvas) {
+    size_t canvas_size = sizeof(color_t) * full_city.city_width_pixels * full_city.chunk_height;
+    full_city.canvas = malloc(canvas_size);
+    if (!full_city.canvas) {
         image_free();
         return;
     }
-    memset(canvas, 0, sizeof(color_t) * city_width_pixels * IMAGE_HEIGHT_CHUNK);
+    memset(full_city.canvas, 0, canvas_size);
+
+    full_city.min_width = (GRID_SIZE * TILE_X_SIZE - full_city.city_width_pixels) / 2 + TILE_X_SIZE;
+    full_city.max_height = (GRID_SIZE * TILE_Y_SIZE + city_height_pixels) / 2;
+    int min_height = full_city.max_height - city_height_pixels - TILE_Y_SIZE;
+    full_city.current_height = image_set_loop_height_limits(min_height, full_city.max_height);
+    full_city.current_row = 0;
+    full_city.total_rows = (city_height_pixels + TILE_Y_SIZE + full_city.chunk_height - 1) / full_city.chunk_height;
+    // The bands are drawn on separate frames, so the city must not change in between
+    full_city.was_paused = game_state_is_paused();
+    game_state_pause();
+    full_city.in_progress = 1;
+}
 
-    int canvas_width = 8 * TILE_X_SIZE;
-    int old_scale = city_view_get_scale();
+static int draw_full_city_rows(void)
+{
+    int canvas_width = full_city.canvas_width;
+    int chunk_height = full_city.chunk_height;
+    int current_height = full_city.current_height;
+    map_tile dummy_tile = { 0, 0, 0 };
+    int y_offset = current_height + chunk_height > full_city.max_height ?
+        chunk_height - (full_city.max_height - current_height) - TILE_Y_SIZE : 0;
+    for (int width = 0; width < full_city.city_width_pixels; width += canvas_width) {
+        int image_section_width = canvas_width;
+        int x_offset = 0;
+        if (canvas_width + width > full_city.city_width_pixels) {
+            image_section_width = full_city.city_width_pixels - width;
+            x_offset = canvas_width - image_section_width - TILE_X_SIZE * 2;
+        }
+        city_view_set_camera_from_pixel_position(full_city.min_width + width, current_height);
+        city_without_overlay_draw(0, 0, &dummy_tile, 0);
+        graphics_renderer()->save_screen_buffer(&full_city.canvas[width], x_offset, TOP_MENU_HEIGHT + y_offset,
+            image_section_width, chunk_height - y_offset, full_city.city_width_pixels);
+    }
+    return image_write_rows(full_city.canvas, full_city.city_width_pixels);
+}
 
+static void continue_full_city_screenshot(void)
+{
+    if (!window_is(WINDOW_CITY) && !window_is(WINDOW_CITY_MILITARY)) {
+        log_error("Full city screenshot interrupted, discarding:", full_city.filename, 0);
+        full_city_abort();
+        return;
+    }
+    if (!image_request_rows()) {
+        log_info("Saved full city screenshot:", full_city.filename, 0);
+        full_city_free();
+        show_saved_notice(full_city.filename);
+        return;
+    }
+    pixel_offset original_camera_pixels;
+    city_view_get_camera_in_pixels(&original_camera_pixels.x, &original_camera_pixels.y);
+    int old_scale = city_view_get_scale();
     int draw_cloud_shadows = config_get(CONFIG_UI_DRAW_CLOUD_SHADOWS);
     config_set(CONFIG_UI_DRAW_CLOUD_SHADOWS, 0);
-
-    int min_width = (GRID_SIZE * TILE_X_SIZE - city_width_pixels) / 2 + TILE_X_SIZE;
-    int max_height = (GRID_SIZE * TILE_Y_SIZE + city_height_pixels) / 2;
-    int min_height = max_height - city_height_pixels - TILE_Y_SIZE;
-    map_tile dummy_tile = { 0, 0, 0 };
-    int error = 0;
-    int base_height = image_set_loop_height_limits(min_height, max_height);
-    int size;
     city_view_set_scale(100);
-    graphics_set_clip_rectangle(0, TOP_MENU_HEIGHT, canvas_width, IMAGE_HEIGHT_CHUNK);
+    graphics_set_clip_rectangle(0, TOP_MENU_HEIGHT, full_city.canvas_width, full_city.chunk_height);
     int viewport_x, viewport_y, viewport_width, viewport_height;
     city_view_get_viewport(&viewport_x, &viewport_y, &viewport_width, &viewport_height);
-    city_view_set_viewport(canvas_width + (city_view_is_sidebar_collapsed() ? 42 : 162),
-        IMAGE_HEIGHT_CHUNK + TOP_MENU_HEIGHT);
-    int current_height = base_height;
-    while ((size = image_request_rows()) != 0) {
-        int y_offset = current_height + IMAGE_HEIGHT_CHUNK > max_height ?
-            IMAGE_HEIGHT_CHUNK - (max_height - current_height) - TILE_Y_SIZE : 0;
-        for (int width = 0; width < city_width_pixels; width += canvas_width) {
-            int image_section_width = canvas_width;
-            int x_offset = 0;
-            if (canvas_width + width > city_width_pixels) {
-                image_section_width = city_width_pixels - width;
-                x_offset = canvas_width - image_section_width - TILE_X_SIZE * 2;
-            }
-            city_view_set_camera_from_pixel_position(min_width + width, current_height);
-            city_without_overlay_draw(0, 0, &dummy_tile, 0);
-            graphics_renderer()->save_screen_buffer(&canvas[width], x_offset, TOP_MENU_HEIGHT + y_offset,
-                image_section_width, IMAGE_HEIGHT_CHUNK - y_offset, city_width_pixels);
-        }
-        if (!image_write_rows(canvas, city_width_pixels)) {
-            log_error("Error writing image", 0, 0);
-            error = 1;
-            break;
-        }
-        current_height += IMAGE_HEIGHT_CHUNK;
-    }
+    city_view_set_viewport(full_city.canvas_width + (city_view_is_sidebar_collapsed() ? 42 : 162),
+        full_city.chunk_height + TOP_MENU_HEIGHT);
+
+    int error = !draw_full_city_rows();
+
     city_view_set_viewport(viewport_width + (city_view_is_sidebar_collapsed() ? 42 : 162), viewport_height + TOP_MENU_HEIGHT);
     city_view_set_scale(old_scale);
     config_set(CONFIG_UI_DRAW_CLOUD_SHADOWS, draw_cloud_shadows);
     graphics_reset_clip_rectangle();
     city_view_set_camera_from_pixel_position(original_camera_pixels.x, original_camera_pixels.y);
-    if (!error) {
-        log_info("Saved full city screenshot:", filename, 0);
-        show_saved_notice(filename);
+    if (error) {
+        log_error("Error writing image", full_city.filename, 0);
+        full_city_abort();
+        return;
     }
-    image_free();
+    full_city.current_height += full_city.chunk_height;
+    full_city.current_row++;
+    show_full_city_progress(full_city.current_row, full_city.total_rows);
     window_invalidate();
 }
 
@@ -378,6 +474,9 @@ static void create_minimap_screenshot(void)
 
 void graphics_save_screenshot(screenshot_type type)
 {
+    if (full_city.in_progress) {
+        return;
+    }
     switch (type) {
         case SCREENSHOT_FULL_CITY:
             create_full_city_screenshot();
@@ -391,3 +490,15 @@ void graphics_save_screenshot(screenshot_type type)
             return;
     }
 }
+
+int graphics_screenshot_in_progress(void)
+{
+    return full_city.in_progress;
+}
+
+void graphics_screenshot_update(void)
+{
+    if (full_city.in_progress) {
+        continue_full_city_screenshot();
+    }
+}
@@ -10,4 +10,16 @@ typedef enum {
 
 void graphics_save_screenshot(screenshot_type type);
 
+/**
+ * Draws and saves the next part of a full city screenshot, if one is being taken.
+ * Must be called once per frame before the window is drawn.
+ */
+void graphics_screenshot_update(void);
+
+/**
+ * Checks whether a full city screenshot is being taken
+ * @return 1 while the screenshot is being drawn, 0 otherwise
+ */
+int graphics_screenshot_in_progress(void);
+
 #endif // GRAPHICS_SCREENSHOT_H
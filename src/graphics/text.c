@@ -8,10 +8,15 @@
 #include "graphics/graphics.h"
 #include "graphics/image.h"
 
+#include <stdlib.h>
 #include <string.h>
 
 #define ELLIPSIS_LENGTH 4
 #define NUMBER_BUFFER_LENGTH 100
+#define WIDTH_CACHE_SIZE 256
+#define WIDTH_CACHE_MAX_LENGTH 48
+#define LAYOUT_CACHE_SIZE 32
+#define MAX_LINES 100
 
 static uint8_t tmp_line[200];
 
@@ -29,6 +34,40 @@ static struct {
     int text_offset_end;
 } input_cursor;
 
+typedef struct {
+    int start;
+    int length;
+    int width;
+} text_line;
+
+typedef struct {
+    uint32_t hash;
+    font_t font;
+    int box_width;
+    int length;
+    int capacity;
+    uint8_t *text;
+    int has_lines;
+    int num_lines;
+    text_line lines[MAX_LINES];
+    int has_measurement;
+    int measured_lines;
+    int largest_width;
+} text_layout;
+
+// Widths and line breaks of recently drawn strings. They are keyed by contents rather than
+// by pointer, since the same text is often written to a different buffer every frame.
+static struct {
+    int font_revision;
+    struct {
+        uint32_t hash;
+        font_t font;
+        int width;
+        uint8_t text[WIDTH_CACHE_MAX_LENGTH];
+    } widths[WIDTH_CACHE_SIZE];
+    text_layout layouts[LAYOUT_CACHE_SIZE];
+} cache;
+
 static struct {
     const uint8_t string[ELLIPSIS_LENGTH];
     int width[FONT_TYPES_MAX];
@@ -87,7 +126,58 @@ void text_draw_cursor(int x_offset, int y_offset, int is_insert)
     }
 }
 
-int text_get_width(const uint8_t *str, font_t font)
+static uint32_t hash_string(const uint8_t *str, int *length)
+{
+    uint32_t hash = 2166136261u;
+    int i;
+    for (i = 0; str[i]; i++) {
+        hash = (hash ^ str[i]) * 16777619u;
+    }
+    *length = i;
+    return hash;
+}
+
+static void check_cache_font_revision(void)
+{
+    if (cache.font_revision == font_revision()) {
+        return;
+    }
+    cache.font_revision = font_revision();
+    memset(cache.widths, 0, sizeof(cache.widths));
+    for (int i = 0; i < LAYOUT_CACHE_SIZE; i++) {
+        cache.layouts[i].length = -1;
+    }
+}
+
+static text_layout *get_layout(const uint8_t *str, int box_width, font_t font)
+{
+    check_cache_font_revision();
+    int length;
+    uint32_t hash = hash_string(str, &length);
+    text_layout *layout = &cache.layouts[(hash ^ ((uint32_t) box_width * 31) ^ font) % LAYOUT_CACHE_SIZE];
+    if (layout->text && layout->hash == hash && layout->font == font && layout->box_width == box_width &&
+        layout->length == length && memcmp(layout->text, str, length) == 0) {
+        return layout;
+    }
+    if (layout->capacity < length + 1) {
+        uint8_t *text = realloc(layout->text, length + 1);
+        if (!text) {
+            return 0;
+        }
+        layout->text = text;
+        layout->capacity = length + 1;
+    }
+    memcpy(layout->text, str, length + 1);
+    layout->hash = hash;
+    layout->font = font;
+    layout->box_width = box_width;
+    layout->length = length;
+    layout->has_lines = 0;
+    layout->has_measurement = 0;
+    return layout;
+}
+
+static int calculate_width(const uint8_t *str, font_t font)
 {
     const font_definition *def = font_definition_for(font);
     int maxlen = 10000;
@@ -108,6 +198,25 @@ int text_get_width(const uint8_t *str, font_t font)
     return width;
 }
 
+int text_get_width(const uint8_t *str, font_t font)
+{
+    int length;
+    uint32_t hash = hash_string(str, &length);
+    if (length >= WIDTH_CACHE_MAX_LENGTH) {
+        return calculate_width(str, font);
+    }
+    check_cache_font_revision();
+    int index = (hash ^ font) % WIDTH_CACHE_SIZE;
+    if (cache.widths[index].hash != hash || cache.widths[index].font != font ||
+        memcmp(cache.widths[index].text, str, length + 1) != 0) {
+        cache.widths[index].hash = hash;
+        cache.widths[index].font = font;
+        cache.widths[index].width = calculate_width(str, font);
+        memcpy(cache.widths[index].text, str, length + 1);
+    }
+    return cache.widths[index].width;
+}
+
 int text_get_number_width(int value, char prefix, const char *postfix, font_t font)
 {
     const font_definition *def = font_definition_for(font);
@@ -559,26 +668,15 @@ void text_draw_number_centered_colored(
     text_draw_centered(str, x_offset, y_offset, box_width, font, color);
 }
 
-int text_draw_multiline(const uint8_t *str, int x_offset, int y_offset, int box_width,
-    int centered, font_t font, color_t color)
+static int split_into_lines(const uint8_t *str, int box_width, font_t font, text_line *lines)
 {
-    int line_height = font_definition_for(font)->line_height;
-    if (line_height < 11) {
-        line_height = 11;
-    }
+    const uint8_t *text = str;
     int has_more_characters = 1;
-    int guard = 0;
-    int y = y_offset;
-    while (has_more_characters) {
-        if (++guard >= 100) {
-            break;
-        }
-        // clear line
-        for (int i = 0; i < 200; i++) {
-            tmp_line[i] = 0;
-        }
+    int num_lines = 0;
+    while (has_more_characters && num_lines < MAX_LINES - 1) {
         int current_width = 0;
-        int line_index = 0;
+        int line_start = -1;
+        int line_end = 0;
         while (has_more_characters) {
             int word_num_chars;
             int word_width = get_word_width(str, font, &word_num_chars, 0);
@@ -594,10 +692,14 @@ int text_draw_multiline(const uint8_t *str, int x_offset, int y_offset, int box_
             }
             current_width += word_width;
             for (int i = 0; i < word_num_chars; i++) {
-                if (line_index == 0 && *str <= ' ') {
+                if (line_start < 0 && *str <= ' ') {
                     str++; // skip whitespace at start of line
                 } else {
-                    tmp_line[line_index++] = *str++;
+                    if (line_start < 0) {
+                        line_start = (int) (str - text);
+                    }
+                    str++;
+                    line_end = (int) (str - text);
                 }
             }
             if (!*str) {
@@ -607,14 +709,49 @@ int text_draw_multiline(const uint8_t *str, int x_offset, int y_offset, int box_
                 break;
             }
         }
-        int line_offset = centered ? (box_width - current_width) / 2 : 0;
+        lines[num_lines].start = line_start < 0 ? 0 : line_start;
+        lines[num_lines].length = line_start < 0 ? 0 : line_end - line_start;
+        lines[num_lines].width = current_width;
+        num_lines++;
+    }
+    return num_lines;
+}
+
+int text_draw_multiline(const uint8_t *str, int x_offset, int y_offset, int box_width,
+    int centered, font_t font, color_t color)
+{
+    static text_line uncached_lines[MAX_LINES];
+    int line_height = font_definition_for(font)->line_height;
+    if (line_height < 11) {
+        line_height = 11;
+    }
+    const text_line *lines;
+    int num_lines;
+    text_layout *layout = get_layout(str, box_width, font);
+    if (!layout) {
+        num_lines = split_into_lines(str, box_width, font, uncached_lines);
+        lines = uncached_lines;
+    } else {
+        if (!layout->has_lines) {
+            layout->num_lines = split_into_lines(str, box_width, font, layout->lines);
+            layout->has_lines = 1;
+        }
+        num_lines = layout->num_lines;
+        lines = layout->lines;
+    }
+    int y = y_offset;
+    for (int i = 0; i < num_lines; i++) {
+        int length = lines[i].length < (int) sizeof(tmp_line) ? lines[i].length : (int) sizeof(tmp_line) - 1;
+        memcpy(tmp_line, &str[lines[i].start], length);
+        tmp_line[length] = 0;
+        int line_offset = centered ? (box_width - lines[i].width) / 2 : 0;
         text_draw(tmp_line, x_offset + line_offset, y, font, color);
         y += line_height + 5;
     }
     return y - y_offset;
 }
 
-int text_measure_multiline(const uint8_t *str, int box_width, font_t font, int *largest_width)
+static int measure_multiline(const uint8_t *str, int box_width, font_t font, int *largest_width)
 {
     // \n is not counted as a word and is only caught it directly after a word: "word \n" won't work correctly
     *largest_width = 0;
@@ -658,3 +795,17 @@ int text_measure_multiline(const uint8_t *str, int box_width, font_t font, int *
     }
     return num_lines;
 }
+
+int text_measure_multiline(const uint8_t *str, int box_width, font_t font, int *largest_width)
+{
+    text_layout *layout = get_layout(str, box_width, font);
+    if (!layout) {
+        return measure_multiline(str, box_width, font, largest_width);
+    }
+    if (!layout->has_measurement) {
+        layout->measured_lines = measure_multiline(str, box_width, font, &layout->largest_width);
+        layout->has_measurement = 1;
+    }
+    *largest_width = layout->largest_width;
+    return layout->measured_lines;
+}
@@ -3,6 +3,7 @@
 #include "core/config.h"
 #include "core/dir.h"
 #include "core/file.h"
+#include "core/log.h"
 #include "core/smacker.h"
 #include "core/time.h"
 #include "game/campaign.h"
@@ -16,9 +17,12 @@
 #include "easyav1.h"
 #include "pl_mpeg/pl_mpeg.h"
 
+#include <stdlib.h>
 #include <string.h>
 
 #define MAX_FRAME_TIME_ADVANCE_MS (1.0 / 30.0)
+#define MAX_READY_FRAMES 4
+#define MAX_FRAMES_DECODED_AHEAD_PER_DRAW 1
 
 typedef enum {
     VIDEO_TYPE_NONE = 0,
@@ -27,6 +31,11 @@ typedef enum {
     VIDEO_TYPE_AV1 = 3
 } video_type;
 
+typedef struct {
+    int time_micros;
+    uint8_t *data;
+} ready_frame;
+
 static struct {
     int is_playing;
     int is_ended;
@@ -45,8 +54,23 @@ static struct {
         time_millis start_render_millis;
         int current_frame;
         int draw_frame;
-        plm_frame_t *mpg_frame;
     } video;
+    struct {
+        ready_frame frames[MAX_READY_FRAMES];
+        int head;
+        int count;
+        int is_yuv;
+        size_t frame_size;
+        struct {
+            int width;
+            int size;
+        } planes[3];
+        int decoded_frames;
+        int is_decoder_finished;
+        int end_micros;
+        int elapsed_micros;
+        time_millis last_millis;
+    } ready;
     struct {
         int has_audio;
         int bitdepth;
@@ -60,8 +84,17 @@ static struct {
     int restart_music;
 } data;
 
+static void clear_ready_frames(void)
+{
+    for (int i = 0; i < MAX_READY_FRAMES; i++) {
+        free(data.ready.frames[i].data);
+    }
+    memset(&data.ready, 0, sizeof(data.ready));
+}
+
 static void close_decoder(void)
 {
+    clear_ready_frames();
     if (data.s) {
         smacker_close(data.s);
         data.s = 0;
@@ -79,11 +112,64 @@ static void close_decoder(void)
     data.type = VIDEO_TYPE_NONE;
 }
 
+static void drop_oldest_ready_frame(void)
+{
+    data.ready.head = (data.ready.head + 1) % MAX_READY_FRAMES;
+    data.ready.count--;
+}
+
+static ready_frame *get_free_ready_frame(int time_micros)
+{
+    if (data.ready.count == MAX_READY_FRAMES) {
+        // Only happens when playback fell behind, in which case the oldest frame would be skipped anyway
+        drop_oldest_ready_frame();
+    }
+    ready_frame *frame = &data.ready.frames[(data.ready.head + data.ready.count) % MAX_READY_FRAMES];
+    if (!frame->data) {
+        frame->data = malloc(data.ready.frame_size);
+        if (!frame->data) {
+            log_error("Not enough memory to decode video frame", 0, 0);
+            data.ready.is_decoder_finished = 1;
+            return 0;
+        }
+    }
+    frame->time_micros = time_micros;
+    data.ready.count++;
+    data.ready.decoded_frames++;
+    data.ready.end_micros = time_micros + data.video.micros_per_frame;
+    return frame;
+}
+
+static void copy_plane(uint8_t *dst, const plm_plane_t *plane)
+{
+    memcpy(dst, plane->data, (size_t) plane->width * plane->height);
+}
+
 static void update_mpg_video(plm_t *plm, plm_frame_t *frame, void *user)
 {
-    data.video.draw_frame = 1;
-    data.video.current_frame++;
-    data.video.mpg_frame = frame;
+    if (!data.ready.frame_size) {
+        if (data.ready.is_yuv) {
+            const plm_plane_t *planes[3] = { &frame->y, &frame->cb, &frame->cr };
+            for (int i = 0; i < 3; i++) {
+                data.ready.planes[i].width = planes[i]->width;
+                data.ready.planes[i].size = planes[i]->width * planes[i]->height;
+                data.ready.frame_size += data.ready.planes[i].size;
+            }
+        } else {
+            data.ready.frame_size = (size_t) data.video.width * data.video.height * sizeof(color_t);
+        }
+    }
+    ready_frame *ready = get_free_ready_frame((int) (frame->time * 1000000));
+    if (!ready) {
+        return;
+    }
+    if (data.ready.is_yuv) {
+        copy_plane(ready->data, &frame->y);
+        copy_plane(ready->data + data.ready.planes[0].size, &frame->cb);
+        copy_plane(ready->data + data.ready.planes[0].size + data.ready.planes[1].size, &frame->cr);
+    } else {
+        plm_frame_to_bgra(frame, ready->data, data.video.width * (int) sizeof(color_t));
+    }
 }
 
 static void update_mpg_audio(plm_t *mpeg, plm_samples_t *samples, void *user)
@@ -307,12 +393,17 @@ int video_start(const char *filename)
 {
     data.is_playing = 0;
     data.is_ended = 0;
+    clear_ready_frames();
 
     if (load_av1(filename) || load_mpg(filename) || load_smk(filename)) {
         sound_music_pause();
         sound_speech_stop();
         int is_yuv = data.type != VIDEO_TYPE_SMK && graphics_renderer()->supports_yuv_image_format();
         graphics_renderer()->create_custom_image(CUSTOM_IMAGE_VIDEO, data.video.width, data.video.height, is_yuv);
+        data.ready.is_yuv = is_yuv && data.type == VIDEO_TYPE_MPG;
+        if (data.type == VIDEO_TYPE_SMK) {
+            data.ready.frame_size = (size_t) data.video.width * data.video.height * sizeof(color_t);
+        }
         if (!is_yuv) {
             data.buffer.pixels = graphics_renderer()->get_custom_image_buffer(CUSTOM_IMAGE_VIDEO, &data.buffer.width);
         }
@@ -336,6 +427,8 @@ void video_size(int *width, int *height)
 void video_init(int restart_music)
 {
     data.video.start_render_millis = system_get_ticks() - 1;
+    data.ready.last_millis = data.video.start_render_millis;
+    data.ready.elapsed_micros = 0;
     data.restart_music = restart_music;
 
     if (data.audio.has_audio) {
@@ -379,123 +472,190 @@ void video_shutdown(void)
     }
 }
 
-static void get_next_frame(void)
+static void decode_smk_frame(void)
 {
-    if (data.type == VIDEO_TYPE_NONE || (data.type == VIDEO_TYPE_SMK && !data.s) ||
-        (data.type == VIDEO_TYPE_MPG && !data.plm) ||
-        (data.type == VIDEO_TYPE_AV1 && !data.easyav1)) {
+    // The first frame is already decoded when the video is opened
+    if (data.ready.decoded_frames > 0) {
+        if (smacker_next_frame(data.s) != SMACKER_FRAME_OK) {
+            data.ready.is_decoder_finished = 1;
+            return;
+        }
+        if (data.audio.has_audio) {
+            int audio_len = smacker_get_frame_audio_size(data.s, 0);
+            const void *audio_data = smacker_get_frame_audio(data.s, 0);
+            if (audio_len > 0) {
+                sound_device_write_custom_music_data(audio_data, audio_len);
+            }
+        }
+    }
+    const unsigned char *frame = smacker_get_frame_video(data.s);
+    const uint32_t *pal = smacker_get_frame_palette(data.s);
+    ready_frame *ready = get_free_ready_frame(data.ready.decoded_frames * data.video.micros_per_frame);
+    if (!ready || !frame || !pal) {
         return;
     }
-    time_millis now_millis = system_get_ticks();
+    color_t *pixel = (color_t *) ready->data;
+    for (int y = 0; y < data.video.height; y++) {
+        int video_y = data.video.y_scale == SMACKER_Y_SCALE_NONE ? y : y / 2;
+        const unsigned char *line = frame + (video_y * data.video.width);
+        for (int x = 0; x < data.video.width; x++) {
+            *pixel = ALPHA_OPAQUE | pal[line[x]];
+            ++pixel;
+        }
+    }
+}
 
+static void decode_next_frame(void)
+{
     if (data.type == VIDEO_TYPE_SMK) {
-        int frame_no = (now_millis - data.video.start_render_millis) * 1000 / data.video.micros_per_frame;
-        data.video.draw_frame = data.video.current_frame == 0;
-        while (frame_no > data.video.current_frame) {
-            if (smacker_next_frame(data.s) != SMACKER_FRAME_OK) {
-                close_decoder();
-                data.is_ended = 1;
-                data.is_playing = 0;
-                end_video();
-                return;
-            }
-            data.video.current_frame++;
-            data.video.draw_frame = 1;
-
-            if (data.audio.has_audio) {
-                int audio_len = smacker_get_frame_audio_size(data.s, 0);
-                const void *audio_data = smacker_get_frame_audio(data.s, 0);
-                if (audio_len > 0) {
-                    sound_device_write_custom_music_data(audio_data, audio_len);
-                }
-            }
-        }
+        decode_smk_frame();
     } else if (data.type == VIDEO_TYPE_MPG) {
-        double elapsed_time = (now_millis - data.video.start_render_millis) / 1000.0;
-        if (elapsed_time > MAX_FRAME_TIME_ADVANCE_MS) {
-            elapsed_time = MAX_FRAME_TIME_ADVANCE_MS;
-        }
-        plm_decode(data.plm, elapsed_time);
-        data.video.start_render_millis = now_millis;
+        // Decodes video and audio up to the same point in time, calling update_mpg_video/audio
+        plm_decode(data.plm, data.video.micros_per_frame / 1000000.0);
         if (plm_has_ended(data.plm)) {
-            close_decoder();
-            data.is_ended = 1;
-            data.is_playing = 0;
-            end_video();
+            data.ready.is_decoder_finished = 1;
         }
-    } else if (data.type == VIDEO_TYPE_AV1) {
-        if (data.audio.has_audio) {
-            const easyav1_audio_frame *audio_frame = easyav1_get_audio_frame(data.easyav1);
-            if (audio_frame) {
-                sound_device_write_custom_music_data(audio_frame->pcm.interlaced, (int) audio_frame->bytes);
+    }
+}
+
+static int newest_ready_frame_is_due(void)
+{
+    if (!data.ready.count) {
+        return 1;
+    }
+    int newest = (data.ready.head + data.ready.count - 1) % MAX_READY_FRAMES;
+    return data.ready.frames[newest].time_micros <= data.ready.elapsed_micros;
+}
+
+static void fill_ready_frames(void)
+{
+    // Decode every frame that is due, plus a limited number of frames ahead of time,
+    // so that the decoding work is spread over the draws in which no new frame is shown
+    int decoded_ahead = 0;
+    int max_decodes = MAX_READY_FRAMES * 2;
+    while (!data.ready.is_decoder_finished && max_decodes-- > 0) {
+        if (!newest_ready_frame_is_due()) {
+            if (data.ready.count == MAX_READY_FRAMES || decoded_ahead >= MAX_FRAMES_DECODED_AHEAD_PER_DRAW) {
+                break;
             }
+            decoded_ahead++;
         }
+        decode_next_frame();
+    }
+}
 
-        if (easyav1_has_video_frame(data.easyav1)) {
-            data.video.draw_frame = 1;
-            data.video.current_frame++;
-        } else {
-            data.video.draw_frame = 0;
-        }
+static void upload_ready_frame(const ready_frame *frame)
+{
+    if (data.ready.is_yuv) {
+        const uint8_t *y = frame->data;
+        const uint8_t *cb = y + data.ready.planes[0].size;
+        const uint8_t *cr = cb + data.ready.planes[1].size;
+        graphics_renderer()->update_custom_image_yuv(CUSTOM_IMAGE_VIDEO, y, data.ready.planes[0].width,
+            cb, data.ready.planes[1].width, cr, data.ready.planes[2].width);
+        return;
+    }
+    const color_t *pixels = (const color_t *) frame->data;
+    for (int y = 0; y < data.video.height; y++) {
+        memcpy(&data.buffer.pixels[y * data.buffer.width], &pixels[y * data.video.width],
+            data.video.width * sizeof(color_t));
+    }
+    graphics_renderer()->update_custom_image(CUSTOM_IMAGE_VIDEO);
+}
 
-        if (easyav1_is_finished(data.easyav1)) {
-            close_decoder();
-            data.is_ended = 1;
-            data.is_playing = 0;
-            end_video();
+static void present_due_frame(void)
+{
+    const ready_frame *due = 0;
+    while (data.ready.count > 0 && data.ready.frames[data.ready.head].time_micros <= data.ready.elapsed_micros) {
+        due = &data.ready.frames[data.ready.head];
+        drop_oldest_ready_frame();
+    }
+    if (due) {
+        // The slot is only reused by the next decode, so it is still valid here
+        upload_ready_frame(due);
+        data.video.current_frame++;
+    }
+}
+
+static void advance_playback_time(void)
+{
+    time_millis now_millis = system_get_ticks();
+    int elapsed_micros = (now_millis - data.ready.last_millis) * 1000;
+    if (data.type == VIDEO_TYPE_MPG && elapsed_micros > MAX_FRAME_TIME_ADVANCE_MS * 1000000) {
+        elapsed_micros = (int) (MAX_FRAME_TIME_ADVANCE_MS * 1000000);
+    }
+    data.ready.elapsed_micros += elapsed_micros;
+    data.ready.last_millis = now_millis;
+}
+
+static void finish_video(void)
+{
+    close_decoder();
+    data.is_ended = 1;
+    data.is_playing = 0;
+    end_video();
+}
+
+static void get_next_av1_frame(void)
+{
+    if (data.audio.has_audio) {
+        const easyav1_audio_frame *audio_frame = easyav1_get_audio_frame(data.easyav1);
+        if (audio_frame) {
+            sound_device_write_custom_music_data(audio_frame->pcm.interlaced, (int) audio_frame->bytes);
         }
     }
+
+    if (easyav1_has_video_frame(data.easyav1)) {
+        data.video.draw_frame = 1;
+        data.video.current_frame++;
+    } else {
+        data.video.draw_frame = 0;
+    }
+
+    if (easyav1_is_finished(data.easyav1)) {
+        finish_video();
+    }
 }
 
-static void update_video_frame(void)
+static void update_av1_video_frame(void)
 {
-    if (data.type == VIDEO_TYPE_NONE) {
+    if (!data.easyav1) {
         return;
     }
-    if (data.type == VIDEO_TYPE_SMK) {
-        const unsigned char *frame = smacker_get_frame_video(data.s);
-        const uint32_t *pal = smacker_get_frame_palette(data.s);
-        if (frame && pal) {
-            for (int y = 0; y < data.video.height; y++) {
-                color_t *pixel = &data.buffer.pixels[y * data.buffer.width];
-                int video_y = data.video.y_scale == SMACKER_Y_SCALE_NONE ? y : y / 2;
-                const unsigned char *line = frame + (video_y * data.video.width);
-                for (int x = 0; x < data.video.width; x++) {
-                    *pixel = ALPHA_OPAQUE | pal[line[x]];
-                    ++pixel;
-                }
-            }
-        }
-    } else if (data.type == VIDEO_TYPE_MPG) {
-        if (graphics_renderer()->supports_yuv_image_format()) {
-            plm_frame_t *frame = data.video.mpg_frame;
-            graphics_renderer()->update_custom_image_yuv(CUSTOM_IMAGE_VIDEO, frame->y.data, frame->y.width,
-                frame->cb.data, frame->cb.width, frame->cr.data, frame->cr.width);
-            return;
-        }
-        plm_frame_to_bgra(data.video.mpg_frame, (uint8_t *) data.buffer.pixels, data.buffer.width * 4);
-    } else if (data.type == VIDEO_TYPE_AV1) {
-        if (!data.easyav1) {
-            return;
-        }
-        const easyav1_video_frame *frame = easyav1_get_video_frame(data.easyav1);
-        if (!frame || !graphics_renderer()->supports_yuv_image_format()) {
-            return;
+    const easyav1_video_frame *frame = easyav1_get_video_frame(data.easyav1);
+    if (!frame || !graphics_renderer()->supports_yuv_image_format()) {
+        return;
+    }
+    graphics_renderer()->update_custom_image_yuv(CUSTOM_IMAGE_VIDEO, frame->data[0], (int) frame->stride[0],
+        frame->data[1], (int) frame->stride[1], frame->data[2], (int) frame->stride[2]);
+}
+
+static void update_video(void)
+{
+    if (data.type == VIDEO_TYPE_NONE || (data.type == VIDEO_TYPE_SMK && !data.s) ||
+        (data.type == VIDEO_TYPE_MPG && !data.plm) ||
+        (data.type == VIDEO_TYPE_AV1 && !data.easyav1)) {
+        return;
+    }
+    if (data.type == VIDEO_TYPE_AV1) {
+        // easyav1 keeps its own clock and frame queue
+        get_next_av1_frame();
+        if (data.video.draw_frame) {
+            update_av1_video_frame();
+            data.video.draw_frame = 0;
         }
-        graphics_renderer()->update_custom_image_yuv(CUSTOM_IMAGE_VIDEO, frame->data[0], (int) frame->stride[0],
-            frame->data[1], (int) frame->stride[1], frame->data[2], (int) frame->stride[2]);
         return;
     }
-    graphics_renderer()->update_custom_image(CUSTOM_IMAGE_VIDEO);
+    advance_playback_time();
+    fill_ready_frames();
+    present_due_frame();
+    if (data.ready.is_decoder_finished && !data.ready.count && data.ready.elapsed_micros >= data.ready.end_micros) {
+        finish_video();
+    }
 }
 
 void video_draw(int x_offset, int y_offset, int width, int height)
 {
-    get_next_frame();
-    if (data.video.draw_frame) {
-        update_video_frame();
-        data.video.draw_frame = 0;
-    }
+    update_video();
 
     float scale = 1.0f;
 
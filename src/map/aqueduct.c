@@ -7,6 +7,14 @@
 
 static grid_u8 aqueduct;
 static grid_u8 aqueduct_backup;
+static grid_journal journal;
+
+static void save_for_restore(int grid_offset)
+{
+    if (map_grid_journal_add(&journal, grid_offset)) {
+        aqueduct_backup.items[grid_offset] = aqueduct.items[grid_offset];
+    }
+}
 
 int map_aqueduct_has_water_access_at(int grid_offset)
 {
@@ -20,16 +28,19 @@ int map_aqueduct_image_at(int grid_offset)
 
 void map_aqueduct_set_water_access(int grid_offset, int value)
 {
+    save_for_restore(grid_offset);
     aqueduct.items[grid_offset] = (value << WATER_ACCESS_OFFSET) | (aqueduct.items[grid_offset] & IMAGE_MASK);
 }
 
 void map_aqueduct_set_image(int grid_offset, int value)
 {
+    save_for_restore(grid_offset);
     aqueduct.items[grid_offset] = (aqueduct.items[grid_offset] & ~IMAGE_MASK) | value;
 }
 
 void map_aqueduct_remove(int grid_offset)
 {
+    save_for_restore(grid_offset);
     aqueduct.items[grid_offset] = 0;
     if (map_aqueduct_image_at(grid_offset + map_grid_delta(0, -1)) == 5) {
         map_aqueduct_set_image(grid_offset + map_grid_delta(0, -1), 1);
@@ -48,26 +59,28 @@ void map_aqueduct_remove(int grid_offset)
 void map_aqueduct_clear(void)
 {
     map_grid_clear_u8(aqueduct.items);
+    map_grid_journal_clear(&journal);
 }
 
 void map_aqueduct_backup(void)
 {
-    map_grid_copy_u8(aqueduct.items, aqueduct_backup.items);
+    map_grid_journal_clear(&journal);
 }
 
 void map_aqueduct_restore(void)
 {
-    map_grid_copy_u8(aqueduct_backup.items, aqueduct.items);
+    map_grid_journal_restore_u8(&journal, aqueduct_backup.items, aqueduct.items);
 }
 
 void map_aqueduct_save_state(buffer *buf, buffer *backup)
 {
     map_grid_save_state_u8(aqueduct.items, buf);
-    map_grid_save_state_u8(aqueduct_backup.items, backup);
+    map_grid_journal_save_state_u8(&journal, aqueduct.items, aqueduct_backup.items, backup);
 }
 
 void map_aqueduct_load_state(buffer *buf, buffer *backup)
 {
     map_grid_load_state_u8(aqueduct.items, buf);
     map_grid_load_state_u8(aqueduct_backup.items, backup);
+    map_grid_journal_rebuild_u8(&journal, aqueduct.items, aqueduct_backup.items);
 }
@@ -273,6 +273,62 @@ void map_grid_copy_u32(const uint32_t *src, uint32_t *dst)
     memcpy(dst, src, GRID_SIZE * GRID_SIZE * sizeof(uint32_t));
 }
 
+void map_grid_journal_clear(grid_journal *journal)
+{
+    for (int i = 0; i < journal->total; i++) {
+        journal->is_saved[journal->offsets[i]] = 0;
+    }
+    journal->total = 0;
+}
+
+int map_grid_journal_add(grid_journal *journal, int grid_offset)
+{
+    if (journal->is_saved[grid_offset]) {
+        return 0;
+    }
+    journal->is_saved[grid_offset] = 1;
+    journal->offsets[journal->total++] = grid_offset;
+    return 1;
+}
+
+void map_grid_journal_restore_u8(const grid_journal *journal, const uint8_t *backup, uint8_t *grid)
+{
+    for (int i = 0; i < journal->total; i++) {
+        int grid_offset = journal->offsets[i];
+        grid[grid_offset] = backup[grid_offset];
+    }
+}
+
+void map_grid_journal_restore_u32(const grid_journal *journal, const uint32_t *backup, uint32_t *grid)
+{
+    for (int i = 0; i < journal->total; i++) {
+        int grid_offset = journal->offsets[i];
+        grid[grid_offset] = backup[grid_offset];
+    }
+}
+
+void map_grid_journal_rebuild_u8(grid_journal *journal, const uint8_t *grid, const uint8_t *backup)
+{
+    map_grid_journal_clear(journal);
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+        if (grid[i] != backup[i]) {
+            map_grid_journal_add(journal, i);
+        }
+    }
+}
+
+void map_grid_journal_save_state_u8(const grid_journal *journal, const uint8_t *grid, const uint8_t *backup,
+    buffer *buf)
+{
+    static grid_u8 full_backup;
+    map_grid_copy_u8(grid, full_backup.items);
+    for (int i = 0; i < journal->total; i++) {
+        int grid_offset = journal->offsets[i];
+        full_backup.items[grid_offset] = backup[grid_offset];
+    }
+    map_grid_save_state_u8(full_backup.items, buf);
+}
+
 void map_grid_save_state_u8(const uint8_t *grid, buffer *buf)
 {
     buffer_write_raw(buf, grid, GRID_SIZE * GRID_SIZE);
@@ -29,6 +29,17 @@ typedef struct {
     uint32_t items[GRID_SIZE * GRID_SIZE];
 } grid_u32;
 
+/**
+ * Tracks which grid offsets were changed since a grid was last backed up.
+ * Only the tracked offsets hold valid values in the backup grid, every other
+ * offset still has the same value as when the backup was made.
+ */
+typedef struct {
+    uint16_t offsets[GRID_SIZE * GRID_SIZE];
+    int total;
+    uint8_t is_saved[GRID_SIZE * GRID_SIZE];
+} grid_journal;
+
 void map_grid_init(int width, int height, int start_offset, int border_size);
 
 int map_grid_is_valid_offset(int grid_offset);
@@ -96,6 +107,29 @@ void map_grid_copy_u16(const uint16_t *src, uint16_t *dst);
 void map_grid_copy_u32(const uint32_t *src, uint32_t *dst);
 
 
+void map_grid_journal_clear(grid_journal *journal);
+
+/**
+ * Adds the grid offset to the journal
+ * @return 1 if the offset was not in the journal yet, so its backup value must be saved now
+ */
+int map_grid_journal_add(grid_journal *journal, int grid_offset);
+
+void map_grid_journal_restore_u8(const grid_journal *journal, const uint8_t *backup, uint8_t *grid);
+
+void map_grid_journal_restore_u32(const grid_journal *journal, const uint32_t *backup, uint32_t *grid);
+
+/**
+ * Rebuilds the journal from a full backup grid, for example after loading it from a saved game
+ */
+void map_grid_journal_rebuild_u8(grid_journal *journal, const uint8_t *grid, const uint8_t *backup);
+
+/**
+ * Saves the full backup grid, combining the journaled backup values with the current values
+ */
+void map_grid_journal_save_state_u8(const grid_journal *journal, const uint8_t *grid, const uint8_t *backup,
+    buffer *buf);
+
 void map_grid_save_state_u8(const uint8_t *grid, buffer *buf);
 
 void map_grid_save_state_i8(const int8_t *grid, buffer *buf);
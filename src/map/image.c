@@ -5,6 +5,7 @@
 #include "core/calc.h"
 #include "core/image.h"
 #include "core/image_group.h"
+#include "map/building.h"
 #include "map/building_tiles.h"
 #include "map/grid.h"
 #include "map/orientation.h"
@@ -12,6 +13,7 @@
 
 static grid_u32 images;
 static grid_u32 images_backup;
+static grid_journal journal;
 
 unsigned int map_image_at(int grid_offset)
 {
@@ -20,27 +22,43 @@ unsigned int map_image_at(int grid_offset)
 
 void map_image_set(int grid_offset, int image_id)
 {
+    if (map_grid_journal_add(&journal, grid_offset)) {
+        images_backup.items[grid_offset] = images.items[grid_offset];
+    }
     images.items[grid_offset] = image_id;
 }
 
 void map_image_backup(void)
 {
-    map_grid_copy_u32(images.items, images_backup.items);
+    map_grid_journal_clear(&journal);
 }
 
 void map_image_restore(void)
 {
-    map_grid_copy_u32(images_backup.items, images.items);
+    map_grid_journal_restore_u32(&journal, images_backup.items, images.items);
 }
 
 void map_image_restore_at(int grid_offset)
 {
-    images.items[grid_offset] = images_backup.items[grid_offset];
+    if (journal.is_saved[grid_offset]) {
+        images.items[grid_offset] = images_backup.items[grid_offset];
+    }
+}
+
+void map_image_restore_except_buildings(void)
+{
+    for (int i = 0; i < journal.total; i++) {
+        int grid_offset = journal.offsets[i];
+        if (!map_building_at(grid_offset)) {
+            images.items[grid_offset] = images_backup.items[grid_offset];
+        }
+    }
 }
 
 void map_image_clear(void)
 {
     map_grid_clear_u32(images.items);
+    map_grid_journal_clear(&journal);
 }
 
 void map_image_init_edges(void)
@@ -92,4 +110,5 @@ void map_image_save_state_legacy(buffer *buf)
 void map_image_load_state_legacy(buffer *buf)
 {
     map_grid_load_state_u16_to_u32(images.items, buf);
+    map_grid_journal_clear(&journal);
 }
@@ -13,6 +13,11 @@ void map_image_restore(void);
 
 void map_image_restore_at(int grid_offset);
 
+/**
+ * Restores the backed up images of all tiles that have no building on them
+ */
+void map_image_restore_except_buildings(void);
+
 void map_image_clear(void);
 void map_image_init_edges(void);
 void map_image_update_all(void);
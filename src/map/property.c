@@ -34,6 +34,22 @@ static grid_u8 bitfields_grid;
 
 static grid_u8 edge_backup;
 static grid_u8 bitfields_backup;
+static grid_journal journal;
+
+// Tiles that may have the construction or deleted bit set, so clearing them
+// after every construction preview does not have to scan the whole map
+static struct {
+    grid_journal tiles;
+    int needs_full_scan;
+} marked = { .needs_full_scan = 1 };
+
+static void save_for_restore(int grid_offset)
+{
+    if (map_grid_journal_add(&journal, grid_offset)) {
+        edge_backup.items[grid_offset] = edge_grid.items[grid_offset];
+        bitfields_backup.items[grid_offset] = bitfields_grid.items[grid_offset];
+    }
+}
 
 static int edge_for(int x, int y)
 {
@@ -53,11 +69,13 @@ int map_property_is_draw_tile_from_buffer(buffer *edge, int grid_offset)
 
 void map_property_mark_draw_tile(int grid_offset)
 {
+    save_for_restore(grid_offset);
     edge_grid.items[grid_offset] |= EDGE_LEFTMOST_TILE;
 }
 
 void map_property_clear_draw_tile(int grid_offset)
 {
+    save_for_restore(grid_offset);
     edge_grid.items[grid_offset] &= ~EDGE_LEFTMOST_TILE;
 }
 
@@ -68,12 +86,18 @@ int map_property_is_native_land(int grid_offset)
 
 void map_property_mark_native_land(int grid_offset)
 {
+    save_for_restore(grid_offset);
     edge_grid.items[grid_offset] |= EDGE_NATIVE_LAND;
 }
 
 void map_property_clear_all_native_land(void)
 {
-    map_grid_and_u8(edge_grid.items, EDGE_NO_NATIVE_LAND);
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+        if (edge_grid.items[i] & ~EDGE_NO_NATIVE_LAND) {
+            save_for_restore(i);
+            edge_grid.items[i] &= EDGE_NO_NATIVE_LAND;
+        }
+    }
 }
 
 int map_property_multi_tile_xy(int grid_offset)
@@ -98,6 +122,7 @@ int map_property_is_multi_tile_xy(int grid_offset, int x, int y)
 
 void map_property_set_multi_tile_xy(int grid_offset, int x, int y, int is_draw_tile)
 {
+    save_for_restore(grid_offset);
     if (is_draw_tile) {
         edge_grid.items[grid_offset] = edge_for(x, y) | EDGE_LEFTMOST_TILE;
     } else {
@@ -107,6 +132,7 @@ void map_property_set_multi_tile_xy(int grid_offset, int x, int y, int is_draw_t
 
 void map_property_clear_multi_tile_xy(int grid_offset)
 {
+    save_for_restore(grid_offset);
     // only keep native land marker
     edge_grid.items[grid_offset] &= EDGE_NATIVE_LAND;
 }
@@ -138,6 +164,7 @@ int map_property_multi_tile_size_from_buffer(buffer *bitfields, int grid_offset)
 
 void map_property_set_multi_tile_size(int grid_offset, int size)
 {
+    save_for_restore(grid_offset);
     bitfields_grid.items[grid_offset] &= BIT_NO_SIZES;
     switch (size) {
         case 2: bitfields_grid.items[grid_offset] |= BIT_SIZE2; break;
@@ -157,6 +184,7 @@ void map_property_init_alternate_terrain(void)
         for (int x = 0; x < map_width; x++) {
             int grid_offset = map_grid_offset(x, y);
             if (map_random_get(grid_offset) & 1) {
+                save_for_restore(grid_offset);
                 bitfields_grid.items[grid_offset] |= BIT_ALTERNATE_TERRAIN;
             }
         }
@@ -175,11 +203,13 @@ int map_property_is_plaza_earthquake_or_overgrown_garden(int grid_offset)
 
 void map_property_mark_plaza_earthquake_or_overgrown_garden(int grid_offset)
 {
+    save_for_restore(grid_offset);
     bitfields_grid.items[grid_offset] |= BIT_PLAZA_EARTHQUAKE_OR_OVERGROWN_GARDEN;
 }
 
 void map_property_clear_plaza_earthquake_or_overgrown_garden(int grid_offset)
 {
+    save_for_restore(grid_offset);
     bitfields_grid.items[grid_offset] &= BIT_NO_PLAZA;
 }
 
@@ -190,11 +220,14 @@ int map_property_is_constructing(int grid_offset)
 
 void map_property_mark_constructing(int grid_offset)
 {
+    save_for_restore(grid_offset);
+    map_grid_journal_add(&marked.tiles, grid_offset);
     bitfields_grid.items[grid_offset] |= BIT_CONSTRUCTION;
 }
 
 void map_property_clear_constructing(int grid_offset)
 {
+    save_for_restore(grid_offset);
     bitfields_grid.items[grid_offset] &= BIT_NO_CONSTRUCTION;
 }
 
@@ -205,35 +238,69 @@ int map_property_is_deleted(int grid_offset)
 
 void map_property_mark_deleted(int grid_offset)
 {
+    save_for_restore(grid_offset);
+    map_grid_journal_add(&marked.tiles, grid_offset);
     bitfields_grid.items[grid_offset] |= BIT_DELETED;
 }
 
 void map_property_clear_deleted(int grid_offset)
 {
+    save_for_restore(grid_offset);
     bitfields_grid.items[grid_offset] &= BIT_NO_DELETED;
 }
 
+static void clear_constructing_and_deleted_tile(int grid_offset)
+{
+    if (bitfields_grid.items[grid_offset] & ~BIT_NO_CONSTRUCTION_AND_DELETED) {
+        save_for_restore(grid_offset);
+        bitfields_grid.items[grid_offset] &= BIT_NO_CONSTRUCTION_AND_DELETED;
+    }
+}
+
 void map_property_clear_constructing_and_deleted(void)
 {
-    map_grid_and_u8(bitfields_grid.items, BIT_NO_CONSTRUCTION_AND_DELETED);
+    if (marked.needs_full_scan) {
+        for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+            clear_constructing_and_deleted_tile(i);
+        }
+        marked.needs_full_scan = 0;
+    } else {
+        for (int i = 0; i < marked.tiles.total; i++) {
+            clear_constructing_and_deleted_tile(marked.tiles.offsets[i]);
+        }
+    }
+    map_grid_journal_clear(&marked.tiles);
+}
+
+static void reset_marked_tiles(void)
+{
+    map_grid_journal_clear(&marked.tiles);
+    marked.needs_full_scan = 1;
 }
 
 void map_property_clear(void)
 {
     map_grid_clear_u8(bitfields_grid.items);
     map_grid_clear_u8(edge_grid.items);
+    map_grid_journal_clear(&journal);
+    reset_marked_tiles();
 }
 
 void map_property_backup(void)
 {
-    map_grid_copy_u8(bitfields_grid.items, bitfields_backup.items);
-    map_grid_copy_u8(edge_grid.items, edge_backup.items);
+    map_grid_journal_clear(&journal);
 }
 
 void map_property_restore(void)
 {
-    map_grid_copy_u8(bitfields_backup.items, bitfields_grid.items);
-    map_grid_copy_u8(edge_backup.items, edge_grid.items);
+    map_grid_journal_restore_u8(&journal, bitfields_backup.items, bitfields_grid.items);
+    map_grid_journal_restore_u8(&journal, edge_backup.items, edge_grid.items);
+    for (int i = 0; i < journal.total; i++) {
+        int grid_offset = journal.offsets[i];
+        if (bitfields_grid.items[grid_offset] & ~BIT_NO_CONSTRUCTION_AND_DELETED) {
+            map_grid_journal_add(&marked.tiles, grid_offset);
+        }
+    }
 }
 
 void map_property_save_state(buffer *bitfields, buffer *edge)
@@ -246,4 +313,6 @@ void map_property_load_state(buffer *bitfields, buffer *edge)
 {
     map_grid_load_state_u8(bitfields_grid.items, bitfields);
     map_grid_load_state_u8(edge_grid.items, edge);
+    map_grid_journal_clear(&journal);
+    reset_marked_tiles();
 }
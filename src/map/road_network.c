@@ -1,6 +1,7 @@
 #include "road_network.h"
 
 #include "city/map.h"
+#include "core/log.h"
 #include "map/data.h"
 #include "map/grid.h"
 #include "map/routing_terrain.h"
@@ -8,88 +9,329 @@
 
 #include <string.h>
 
-#define MAX_QUEUE 1000
+#define MAX_NETWORKS 256
+#define MAX_CHANGED_TILES 1000
 
 static const int ADJACENT_OFFSETS[] = {-GRID_SIZE, 1, GRID_SIZE, -1};
 
 static grid_u8 network;
+static grid_u8 is_network_tile;
+static grid_u8 is_changed;
 
+// Union-find over network ids: merging two networks when a tile joins them
+// only touches these tables, not the tiles already labelled
 static struct {
-    int items[MAX_QUEUE];
+    uint8_t parent[MAX_NETWORKS];
+    uint8_t in_use[MAX_NETWORKS];
+    int size[MAX_NETWORKS];
+    int needs_rebuild;
+    int revision;
+} networks;
+
+static struct {
+    int items[MAX_CHANGED_TILES];
+    int total;
+} changes;
+
+static struct {
+    int items[GRID_SIZE * GRID_SIZE];
     int head;
     int tail;
 } queue;
 
-void map_road_network_clear(void)
+static struct {
+    int items[GRID_SIZE * GRID_SIZE];
+    int total;
+} cleared;
+
+static void reset_networks(void)
 {
+    int revision = networks.revision;
+    memset(&networks, 0, sizeof(networks));
+    networks.revision = revision + 1;
+    for (int i = 0; i < MAX_NETWORKS; i++) {
+        networks.parent[i] = i;
+    }
+    changes.total = 0;
     map_grid_clear_u8(network.items);
+    map_grid_clear_u8(is_changed.items);
 }
 
-int map_road_network_get(int grid_offset)
+void map_road_network_clear(void)
 {
-    return network.items[grid_offset];
+    reset_networks();
+    map_grid_clear_u8(is_network_tile.items);
+    networks.needs_rebuild = 1;
 }
 
-static int mark_road_network(int grid_offset, uint8_t network_id)
+static int find_root(int network_id)
 {
-    memset(&queue, 0, sizeof(queue));
-    int guard = 0;
-    int next_offset;
-    int size = 1;
-    do {
-        if (++guard >= GRID_SIZE * GRID_SIZE) {
-            break;
+    while (networks.parent[network_id] != network_id) {
+        networks.parent[network_id] = networks.parent[networks.parent[network_id]];
+        network_id = networks.parent[network_id];
+    }
+    return network_id;
+}
+
+static void join_networks(int network_id1, int network_id2)
+{
+    int root1 = find_root(network_id1);
+    int root2 = find_root(network_id2);
+    if (root1 == root2) {
+        return;
+    }
+    if (networks.size[root1] < networks.size[root2]) {
+        int tmp = root1;
+        root1 = root2;
+        root2 = tmp;
+    }
+    networks.parent[root2] = root1;
+    networks.size[root1] += networks.size[root2];
+    networks.size[root2] = 0;
+}
+
+static int allocate_network(void)
+{
+    for (int i = 1; i < MAX_NETWORKS; i++) {
+        if (!networks.in_use[i]) {
+            networks.in_use[i] = 1;
+            networks.parent[i] = i;
+            networks.size[i] = 0;
+            return i;
         }
-        network.items[grid_offset] = network_id;
-        next_offset = -1;
+    }
+    return 0;
+}
+
+int map_road_network_revision(void)
+{
+    return networks.revision;
+}
+
+int map_road_network_get(int grid_offset)
+{
+    int network_id = network.items[grid_offset];
+    return network_id ? find_root(network_id) : 0;
+}
+
+static int can_be_part_of_network(int grid_offset)
+{
+    return map_routing_citizen_is_passable(grid_offset) && (
+        map_routing_citizen_is_road(grid_offset) ||
+        map_terrain_is(grid_offset, TERRAIN_ACCESS_RAMP) ||
+        map_routing_citizen_is_highway(grid_offset));
+}
+
+static void mark_road_network(int grid_offset, int network_id)
+{
+    queue.head = 0;
+    queue.tail = 0;
+    network.items[grid_offset] = network_id;
+    networks.size[find_root(network_id)]++;
+    queue.items[queue.tail++] = grid_offset;
+    while (queue.head < queue.tail) {
+        grid_offset = queue.items[queue.head++];
         for (int i = 0; i < 4; i++) {
             int new_offset = grid_offset + ADJACENT_OFFSETS[i];
-            if (map_routing_citizen_is_passable(new_offset) && !network.items[new_offset]) {
-                if (
-                    map_routing_citizen_is_road(new_offset) ||
-                    map_terrain_is(new_offset, TERRAIN_ACCESS_RAMP) ||
-                    map_routing_citizen_is_highway(new_offset)
-                ) {
-                    network.items[new_offset] = network_id;
-                    size++;
-                    if (next_offset == -1) {
-                        next_offset = new_offset;
-                    } else {
-                        queue.items[queue.tail++] = new_offset;
-                        if (queue.tail >= MAX_QUEUE) {
-                            queue.tail = 0;
-                        }
-                    }
-                }
+            if (!is_network_tile.items[new_offset]) {
+                continue;
             }
+            if (network.items[new_offset]) {
+                // Only happens when a tile added since the last update connects two networks
+                join_networks(network_id, network.items[new_offset]);
+            } else {
+                network.items[new_offset] = network_id;
+                networks.size[find_root(network_id)]++;
+                queue.items[queue.tail++] = new_offset;
+            }
+        }
+    }
+}
+
+static void update_largest_road_networks(void)
+{
+    city_map_clear_largest_road_networks();
+    for (int i = 1; i < MAX_NETWORKS; i++) {
+        if (networks.in_use[i] && networks.parent[i] == i) {
+            city_map_add_to_largest_road_networks(i, networks.size[i]);
         }
-        if (next_offset == -1) {
-            if (queue.head == queue.tail) {
-                return size;
+    }
+}
+
+void map_road_network_check_changes(void)
+{
+    if (networks.needs_rebuild) {
+        return;
+    }
+    int grid_offset = map_data.start_offset;
+    for (int y = 0; y < map_data.height; y++, grid_offset += map_data.border_size) {
+        for (int x = 0; x < map_data.width; x++, grid_offset++) {
+            int is_part = can_be_part_of_network(grid_offset);
+            if (is_part == is_network_tile.items[grid_offset]) {
+                continue;
             }
-            next_offset = queue.items[queue.head++];
-            if (queue.head >= MAX_QUEUE) {
-                queue.head = 0;
+            is_network_tile.items[grid_offset] = is_part;
+            networks.revision++;
+            if (is_changed.items[grid_offset]) {
+                continue;
             }
+            if (changes.total >= MAX_CHANGED_TILES) {
+                networks.needs_rebuild = 1;
+                return;
+            }
+            is_changed.items[grid_offset] = 1;
+            changes.items[changes.total++] = grid_offset;
         }
-        grid_offset = next_offset;
-    } while (next_offset > -1);
-    return size;
+    }
 }
 
-void map_road_network_update(void)
+static int remove_tile(int grid_offset)
 {
-    city_map_clear_largest_road_networks();
-    map_grid_clear_u8(network.items);
-    int network_id = 1;
+    // Clear the whole network the tile belonged to, then re-flood it from its road tiles,
+    // since removing the tile may have split it into several networks
+    int root = find_root(network.items[grid_offset]);
+    cleared.total = 0;
+    network.items[grid_offset] = 0;
+    cleared.items[cleared.total++] = grid_offset;
+    for (int n = 0; n < cleared.total; n++) {
+        for (int i = 0; i < 4; i++) {
+            int new_offset = cleared.items[n] + ADJACENT_OFFSETS[i];
+            if (network.items[new_offset] && find_root(network.items[new_offset]) == root) {
+                network.items[new_offset] = 0;
+                cleared.items[cleared.total++] = new_offset;
+            }
+        }
+    }
+    uint8_t roots[MAX_NETWORKS];
+    for (int i = 1; i < MAX_NETWORKS; i++) {
+        roots[i] = networks.in_use[i] ? find_root(i) : 0;
+    }
+    for (int i = 1; i < MAX_NETWORKS; i++) {
+        if (roots[i] == root) {
+            networks.in_use[i] = 0;
+            networks.parent[i] = i;
+            networks.size[i] = 0;
+        }
+    }
+    for (int n = 0; n < cleared.total; n++) {
+        int offset = cleared.items[n];
+        if (!network.items[offset] && is_network_tile.items[offset] && map_terrain_is(offset, TERRAIN_ROAD)) {
+            int network_id = allocate_network();
+            if (!network_id) {
+                return 0;
+            }
+            mark_road_network(offset, network_id);
+        }
+    }
+    return 1;
+}
+
+static int add_tile(int grid_offset)
+{
+    int network_id = 0;
+    for (int i = 0; i < 4 && !network_id; i++) {
+        network_id = network.items[grid_offset + ADJACENT_OFFSETS[i]];
+    }
+    if (!network_id) {
+        if (!map_terrain_is(grid_offset, TERRAIN_ROAD)) {
+            // Highways and ramps only become part of a network through a road
+            return 1;
+        }
+        network_id = allocate_network();
+        if (!network_id) {
+            return 0;
+        }
+    }
+    mark_road_network(grid_offset, network_id);
+    return 1;
+}
+
+void map_road_network_rebuild(void)
+{
+    reset_networks();
     int grid_offset = map_data.start_offset;
+    for (int y = 0; y < map_data.height; y++, grid_offset += map_data.border_size) {
+        for (int x = 0; x < map_data.width; x++, grid_offset++) {
+            is_network_tile.items[grid_offset] = can_be_part_of_network(grid_offset);
+        }
+    }
+    grid_offset = map_data.start_offset;
     for (int y = 0; y < map_data.height; y++, grid_offset += map_data.border_size) {
         for (int x = 0; x < map_data.width; x++, grid_offset++) {
             if (map_terrain_is(grid_offset, TERRAIN_ROAD) && !network.items[grid_offset]) {
-                int size = mark_road_network(grid_offset, network_id);
-                city_map_add_to_largest_road_networks(network_id, size);
-                network_id++;
+                int network_id = allocate_network();
+                if (!network_id) {
+                    log_error("Too many road networks, not all roads will be assigned to one", 0, 0);
+                    update_largest_road_networks();
+                    return;
+                }
+                mark_road_network(grid_offset, network_id);
             }
         }
     }
+    update_largest_road_networks();
+}
+
+#ifdef VERIFY_ROAD_NETWORK
+static void verify_against_full_update(void)
+{
+    static grid_u8 incremental;
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+        incremental.items[i] = map_road_network_get(i);
+    }
+    map_road_network_rebuild();
+    uint8_t incremental_to_full[MAX_NETWORKS] = { 0 };
+    uint8_t full_to_incremental[MAX_NETWORKS] = { 0 };
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+        int incremental_id = incremental.items[i];
+        int full_id = map_road_network_get(i);
+        if (!incremental_id && !full_id) {
+            continue;
+        }
+        if (!incremental_id || !full_id) {
+            log_error("Road network mismatch at grid offset", 0, i);
+            return;
+        }
+        if (!incremental_to_full[incremental_id] && !full_to_incremental[full_id]) {
+            incremental_to_full[incremental_id] = full_id;
+            full_to_incremental[full_id] = incremental_id;
+        } else if (incremental_to_full[incremental_id] != full_id ||
+            full_to_incremental[full_id] != incremental_id) {
+            log_error("Road network mismatch at grid offset", 0, i);
+            return;
+        }
+    }
+}
+#endif
+
+void map_road_network_update(void)
+{
+    if (networks.needs_rebuild) {
+        map_road_network_rebuild();
+        return;
+    }
+    if (!changes.total) {
+        return;
+    }
+    for (int i = 0; i < changes.total; i++) {
+        int grid_offset = changes.items[i];
+        if (!is_network_tile.items[grid_offset] && network.items[grid_offset] && !remove_tile(grid_offset)) {
+            map_road_network_rebuild();
+            return;
+        }
+    }
+    for (int i = 0; i < changes.total; i++) {
+        int grid_offset = changes.items[i];
+        is_changed.items[grid_offset] = 0;
+        if (is_network_tile.items[grid_offset] && !network.items[grid_offset] && !add_tile(grid_offset)) {
+            map_road_network_rebuild();
+            return;
+        }
+    }
+    changes.total = 0;
+#ifdef VERIFY_ROAD_NETWORK
+    verify_against_full_update();
+#else
+    update_largest_road_networks();
+#endif
 }
@@ -5,6 +5,28 @@ void map_road_network_clear(void);
 
 int map_road_network_get(int grid_offset);
 
+/**
+ * Gets a number that changes whenever a tile joins or leaves a road network
+ * @return The current road network revision
+ */
+int map_road_network_revision(void);
+
+/**
+ * Records the tiles that joined or left a road network since the last call.
+ * Must be called whenever the citizen routing terrain has been updated.
+ */
+void map_road_network_check_changes(void);
+
+/**
+ * Updates the road network ids for the tiles that changed since the last update.
+ * Added tiles are merged into their neighbouring networks, removed tiles cause
+ * only the network they belonged to to be relabelled.
+ */
 void map_road_network_update(void);
 
+/**
+ * Relabels all road networks from scratch
+ */
+void map_road_network_rebuild(void);
+
 #endif // MAP_ROAD_NETWORK_H
@@ -7,14 +7,21 @@
 #include "map/grid.h"
 #include "map/road_aqueduct.h"
 #include "map/routing_data.h"
+#include "map/routing_terrain.h"
 #include "map/terrain.h"
 #include "map/tiles.h"
 
 #include <stdlib.h>
+#include <string.h>
 
 #define MAX_QUEUE GRID_SIZE * GRID_SIZE
 #define GUARD 50000
 
+// A step costs at most 2 and moves the target at most 2 tiles further away,
+// so queued priorities never exceed the lowest one by more than 4
+#define ORDERED_QUEUE_BUCKETS 8
+#define ORDERED_QUEUE_MAX_ENTRIES (2 * MAX_QUEUE)
+
 #define UNTIL_STOP 0
 #define UNTIL_CONTINUE 1
 
@@ -50,6 +57,20 @@ static struct {
     int items[MAX_QUEUE];
 } queue;
 
+// Bucket queue for route_queue_from_to, with one bucket per priority. The priority of a tile
+// only grows along a route, so the lowest bucket is found by moving a cursor forward. A tile whose
+// priority drops is pushed again and its older entry is skipped when popped.
+static struct {
+    int head[ORDERED_QUEUE_BUCKETS];
+    int cursor;
+    int free_entry;
+    int used_entries;
+    struct {
+        int offset;
+        int next;
+    } entries[ORDERED_QUEUE_MAX_ENTRIES];
+} ordered_queue;
+
 static grid_u8 water_drag;
 
 static struct {
@@ -57,6 +78,18 @@ static struct {
     time_millis last_check;
 } fighting_data;
 
+// The flood for a road, highway or aqueduct drag only depends on the start tile, the land and the buildings,
+// which are restored before every preview update, so its result is reused until one of those changes
+static struct {
+    int is_valid;
+    routed_building_type type;
+    int source_offset;
+    int result;
+    int land_revision;
+    int buildings_revision;
+    grid_i16 determined;
+} building_distance_cache;
+
 static struct {
     int through_building_id;
     int dest_building_id;
@@ -103,80 +136,74 @@ static inline int queue_pop(void)
     return result;
 }
 
-static inline int ordered_queue_parent(int index)
-{
-    return (index - 1) / 2;
-}
-
-static inline void ordered_queue_swap(int first, int second)
+static void ordered_queue_clear(void)
 {
-    int temp = queue.items[first];
-    queue.items[first] = queue.items[second];
-    queue.items[second] = temp;
+    for (int i = 0; i < ORDERED_QUEUE_BUCKETS; i++) {
+        ordered_queue.head[i] = -1;
+    }
+    ordered_queue.cursor = 0;
+    ordered_queue.free_entry = -1;
+    ordered_queue.used_entries = 0;
 }
 
-static void ordered_queue_reorder(int start_index)
+static int ordered_queue_push(int offset, int priority)
 {
-    int left_child = 2 * start_index + 1;
-    if (left_child >= queue.tail) {
-        return;
-    }
-    int right_child = left_child + 1;
-    int smallest = start_index;
-    int16_t *offset_smallest = &distance.possible.items[queue.items[smallest]];
-    if (distance.possible.items[queue.items[left_child]] < *offset_smallest) {
-        smallest = left_child;
-        offset_smallest = &distance.possible.items[queue.items[smallest]];
-    }
-    if (right_child < queue.tail &&
-        distance.possible.items[queue.items[right_child]] < *offset_smallest) {
-        smallest = right_child;
+    int entry = ordered_queue.free_entry;
+    if (entry >= 0) {
+        ordered_queue.free_entry = ordered_queue.entries[entry].next;
+    } else if (ordered_queue.used_entries < ORDERED_QUEUE_MAX_ENTRIES) {
+        entry = ordered_queue.used_entries++;
+    } else {
+        return 0;
     }
-    if (smallest != start_index) {
-        ordered_queue_swap(start_index, smallest);
-        ordered_queue_reorder(smallest);
+    // The start tile is queued without its distance to the destination, so the priorities
+    // of the tiles around it can be far from the cursor
+    if (!queue.tail || priority < ordered_queue.cursor) {
+        ordered_queue.cursor = priority;
     }
+    int bucket = priority & (ORDERED_QUEUE_BUCKETS - 1);
+    ordered_queue.entries[entry].offset = offset;
+    ordered_queue.entries[entry].next = ordered_queue.head[bucket];
+    ordered_queue.head[bucket] = entry;
+    return 1;
 }
 
-static inline int ordered_queue_pop(void)
-{
-    int min = queue.items[0];
-    queue.items[0] = queue.items[--queue.tail];
-    ordered_queue_reorder(0);
-    return min;
-}
-
-static inline void ordered_queue_reduce_index(int index, int offset, int dist)
+static int ordered_queue_pop(void)
 {
-    queue.items[index] = offset;
-    while (index && distance.possible.items[queue.items[ordered_queue_parent(index)]] > dist) {
-        ordered_queue_swap(index, ordered_queue_parent(index));
-        index = ordered_queue_parent(index);
+    while (1) {
+        int bucket = ordered_queue.cursor & (ORDERED_QUEUE_BUCKETS - 1);
+        int entry = ordered_queue.head[bucket];
+        if (entry < 0) {
+            ordered_queue.cursor++;
+            continue;
+        }
+        int offset = ordered_queue.entries[entry].offset;
+        ordered_queue.head[bucket] = ordered_queue.entries[entry].next;
+        ordered_queue.entries[entry].next = ordered_queue.free_entry;
+        ordered_queue.free_entry = entry;
+        // Skip entries left behind when the tile was queued again with a lower priority
+        if (distance.possible.items[offset] == ordered_queue.cursor) {
+            queue.tail--;
+            return offset;
+        }
     }
 }
 
 static void ordered_enqueue(int next_offset, int current_dist, int remaining_dist)
 {
     int possible_dist = remaining_dist + current_dist;
-    int index = queue.tail;
-    if (distance.possible.items[next_offset]) {
-        if (distance.possible.items[next_offset] <= possible_dist) {
-            return;
-        } else {
-            for (int i = 0; i < queue.tail; i++) {
-                if (queue.items[i] == next_offset) {
-                    index = i;
-                    break;
-                }
-            }
-        }
-    } else {
+    int is_queued = distance.possible.items[next_offset] != 0;
+    if (is_queued && distance.possible.items[next_offset] <= possible_dist) {
+        return;
+    }
+    if (!ordered_queue_push(next_offset, possible_dist)) {
+        return;
+    }
+    if (!is_queued) {
         queue.tail++;
     }
     distance.determined.items[next_offset] = current_dist;
     distance.possible.items[next_offset] = possible_dist;
-
-    ordered_queue_reduce_index(index, next_offset, possible_dist);
 }
 
 static inline int valid_offset(int grid_offset, int possible_dist)
@@ -199,13 +226,15 @@ static int receive_highway_bonus(int offset, int direction)
     return 0;
 }
 
+// Tiles not set in the passable grid are skipped without calling the callback. Either may be 0.
 static void route_queue_from_to(int src_x, int src_y, int dst_x, int dst_y, int num_directions, int max_tiles,
-    int (*callback)(int offset, int next_offset, int direction))
+    const passable_grid *passable, int (*callback)(int offset, int next_offset, int direction))
 {
     clear_data();
     distance.dst_x = dst_x;
     distance.dst_y = dst_y;
     int dest = map_grid_offset(dst_x, dst_y);
+    ordered_queue_clear();
     ordered_enqueue(map_grid_offset(src_x, src_y), 1, 0);
     int tiles = 0;
     while (queue.tail) {
@@ -223,7 +252,9 @@ static void route_queue_from_to(int src_x, int src_y, int dst_x, int dst_y, int
             if (receive_highway_bonus(next_offset, i)) {
                 dist--;
             }
-            if (valid_offset(next_offset, dist) && callback(offset, next_offset, i)) {
+            if (valid_offset(next_offset, dist) &&
+                (!passable || map_routing_passable_at(passable, next_offset)) &&
+                (!callback || callback(offset, next_offset, i))) {
                 ordered_enqueue(next_offset, dist, remaining_dist);
             }
         }
@@ -461,16 +492,34 @@ static int map_can_place_initial_road_or_aqueduct(int grid_offset, int is_aquedu
     }
 }
 
-int map_routing_calculate_distances_for_building(routed_building_type type, int x, int y)
+static int restore_cached_distances_for_building(routed_building_type type, int source_offset, int *result)
 {
-    int source_offset = map_grid_offset(x, y);
-    if (type == ROUTED_BUILDING_WALL) {
-        route_queue_all_from(source_offset, DIRECTIONS_NO_DIAGONALS, callback_calc_distance_build_wall, 0);
-        return 1;
+    if (!building_distance_cache.is_valid ||
+        building_distance_cache.type != type ||
+        building_distance_cache.source_offset != source_offset ||
+        building_distance_cache.land_revision != map_routing_land_revision() ||
+        building_distance_cache.buildings_revision != building_type_lists_revision()) {
+        return 0;
     }
+    memcpy(distance.determined.items, building_distance_cache.determined.items, sizeof(distance.determined.items));
+    *result = building_distance_cache.result;
+    return 1;
+}
 
-    clear_data();
+static int cache_distances_for_building(routed_building_type type, int source_offset, int result)
+{
+    building_distance_cache.is_valid = 1;
+    building_distance_cache.type = type;
+    building_distance_cache.source_offset = source_offset;
+    building_distance_cache.result = result;
+    building_distance_cache.land_revision = map_routing_land_revision();
+    building_distance_cache.buildings_revision = building_type_lists_revision();
+    memcpy(building_distance_cache.determined.items, distance.determined.items, sizeof(distance.determined.items));
+    return result;
+}
 
+static int calculate_distances_for_building(routed_building_type type, int source_offset)
+{
     if (type == ROUTED_BUILDING_HIGHWAY) {
         if (!can_build_highway(source_offset, 0)) {
             return 0;
@@ -478,14 +527,6 @@ int map_routing_calculate_distances_for_building(routed_building_type type, int
         route_queue_all_from(source_offset, DIRECTIONS_NO_DIAGONALS, callback_calc_distance_build_highway, 0);
         return 1;
     }
-    if (type == BUILDING_DRAGGABLE_RESERVOIR) {
-        if (map_can_place_initial_reservoir(source_offset)) {
-            return 1;
-        } else {
-            return 0;
-        }
-
-    }
     if (!map_can_place_initial_road_or_aqueduct(source_offset, type != ROUTED_BUILDING_ROAD)) {
         return 0;
     }
@@ -502,6 +543,31 @@ int map_routing_calculate_distances_for_building(routed_building_type type, int
     return 1;
 }
 
+int map_routing_calculate_distances_for_building(routed_building_type type, int x, int y)
+{
+    int source_offset = map_grid_offset(x, y);
+    if (type == ROUTED_BUILDING_WALL) {
+        route_queue_all_from(source_offset, DIRECTIONS_NO_DIAGONALS, callback_calc_distance_build_wall, 0);
+        return 1;
+    }
+
+    clear_data();
+
+    if (type == BUILDING_DRAGGABLE_RESERVOIR) {
+        if (map_can_place_initial_reservoir(source_offset)) {
+            return 1;
+        } else {
+            return 0;
+        }
+
+    }
+    int result;
+    if (restore_cached_distances_for_building(type, source_offset, &result)) {
+        return result;
+    }
+    return cache_distances_for_building(type, source_offset, calculate_distances_for_building(type, source_offset));
+}
+
 static int callback_delete_wall_aqueduct(int next_offset, int dist, int direction)
 {
     if (terrain_land_citizen.items[next_offset] < CITIZEN_0_ROAD) {
@@ -549,28 +615,17 @@ static inline int has_fighting_enemy(int grid_offset)
 
 static int callback_travel_citizen_land(int offset, int next_offset, int direction)
 {
-    if (terrain_land_citizen.items[next_offset] >= 0 && !has_fighting_friendly(next_offset)) {
-        return 1;
-    }
-    return 0;
+    return !has_fighting_friendly(next_offset);
 }
 
 int map_routing_citizen_can_travel_over_land(int src_x, int src_y, int dst_x, int dst_y, int num_directions)
 {
     ++stats.total_routes_calculated;
-    route_queue_from_to(src_x, src_y, dst_x, dst_y, num_directions, 0, callback_travel_citizen_land);
+    route_queue_from_to(src_x, src_y, dst_x, dst_y, num_directions, 0,
+        &terrain_passable[PASSABLE_CITIZEN_LAND], callback_travel_citizen_land);
     return distance.determined.items[map_grid_offset(dst_x, dst_y)] != 0;
 }
 
-static int callback_travel_citizen_road_garden(int offset, int next_offset, int direction)
-{
-    if (terrain_land_citizen.items[next_offset] == CITIZEN_0_ROAD ||
-        terrain_land_citizen.items[next_offset] == CITIZEN_2_PASSABLE_TERRAIN) {
-        return 1;
-    }
-    return 0;
-}
-
 int map_routing_citizen_can_travel_over_road_garden(int src_x, int src_y, int dst_x, int dst_y, int num_directions)
 {
     int dst_offset = map_grid_offset(dst_x, dst_y);
@@ -579,19 +634,11 @@ int map_routing_citizen_can_travel_over_road_garden(int src_x, int src_y, int ds
         return 0;
     }
     ++stats.total_routes_calculated;
-    route_queue_from_to(src_x, src_y, dst_x, dst_y, num_directions, 0, callback_travel_citizen_road_garden);
+    route_queue_from_to(src_x, src_y, dst_x, dst_y, num_directions, 0,
+        &terrain_passable[PASSABLE_CITIZEN_ROAD_GARDEN], 0);
     return distance.determined.items[dst_offset] != 0;
 }
 
-static int callback_travel_citizen_road_garden_highway(int offset, int next_offset, int direction)
-{
-    if (terrain_land_citizen.items[next_offset] >= CITIZEN_0_ROAD &&
-        terrain_land_citizen.items[next_offset] <= CITIZEN_2_PASSABLE_TERRAIN) {
-        return 1;
-    }
-    return 0;
-}
-
 int map_routing_citizen_can_travel_over_road_garden_highway(int src_x, int src_y, int dst_x, int dst_y, int num_directions)
 {
     int dst_offset = map_grid_offset(dst_x, dst_y);
@@ -600,23 +647,15 @@ int map_routing_citizen_can_travel_over_road_garden_highway(int src_x, int src_y
         return 0;
     }
     ++stats.total_routes_calculated;
-    route_queue_from_to(src_x, src_y, dst_x, dst_y, num_directions, 0, callback_travel_citizen_road_garden_highway);
+    route_queue_from_to(src_x, src_y, dst_x, dst_y, num_directions, 0,
+        &terrain_passable[PASSABLE_CITIZEN_ROAD_GARDEN_HIGHWAY], 0);
     return distance.determined.items[dst_offset] != 0;
 }
 
-static int callback_travel_walls(int offset, int next_offset, int direction)
-{
-    if (terrain_walls.items[next_offset] >= WALL_0_PASSABLE &&
-        terrain_walls.items[next_offset] <= 2) {
-        return 1;
-    }
-    return 0;
-}
-
 int map_routing_can_travel_over_walls(int src_x, int src_y, int dst_x, int dst_y, int num_directions)
 {
     ++stats.total_routes_calculated;
-    route_queue_from_to(src_x, src_y, dst_x, dst_y, num_directions, 0, callback_travel_walls);
+    route_queue_from_to(src_x, src_y, dst_x, dst_y, num_directions, 0, &terrain_passable[PASSABLE_WALLS], 0);
     return distance.determined.items[map_grid_offset(dst_x, dst_y)] != 0;
 }
 
@@ -638,14 +677,7 @@ static int callback_travel_noncitizen_land_through_building(int offset, int next
 
 static int callback_travel_noncitizen_land(int offset, int next_offset, int direction)
 {
-    if (has_fighting_enemy(next_offset)) {
-        return 0;
-    }
-    uint8_t terrain = terrain_land_noncitizen.items[next_offset];
-    if (terrain < NONCITIZEN_5_FORT) {
-        return 1;
-    }
-    return 0;
+    return !has_fighting_enemy(next_offset);
 }
 
 int map_routing_noncitizen_can_travel_over_land(
@@ -658,25 +690,20 @@ int map_routing_noncitizen_can_travel_over_land(
         state.through_building_id = only_through_building_id;
         // due to formation offsets, the destination building may not be the same as the "through building" (a.k.a. target building)
         state.dest_building_id = map_building_at(map_grid_offset(dst_x, dst_y));
-        route_queue_from_to(src_x, src_y, dst_x, dst_y, num_directions, 0, callback_travel_noncitizen_land_through_building);
+        route_queue_from_to(src_x, src_y, dst_x, dst_y, num_directions, 0,
+            0, callback_travel_noncitizen_land_through_building);
     } else {
-        route_queue_from_to(src_x, src_y, dst_x, dst_y, num_directions, max_tiles, callback_travel_noncitizen_land);
+        route_queue_from_to(src_x, src_y, dst_x, dst_y, num_directions, max_tiles,
+            &terrain_passable[PASSABLE_NONCITIZEN_LAND], callback_travel_noncitizen_land);
     }
     return distance.determined.items[map_grid_offset(dst_x, dst_y)] != 0;
 }
 
-static int callback_travel_noncitizen_through_everything(int offset, int next_offset, int direction)
-{
-    if (terrain_land_noncitizen.items[next_offset] >= NONCITIZEN_0_PASSABLE) {
-        return 1;
-    }
-    return 0;
-}
-
 int map_routing_noncitizen_can_travel_through_everything(int src_x, int src_y, int dst_x, int dst_y, int num_directions)
 {
     ++stats.total_routes_calculated;
-    route_queue_from_to(src_x, src_y, dst_x, dst_y, num_directions, 0, callback_travel_noncitizen_through_everything);
+    route_queue_from_to(src_x, src_y, dst_x, dst_y, num_directions, 0,
+        &terrain_passable[PASSABLE_NONCITIZEN_THROUGH_EVERYTHING], 0);
     return distance.determined.items[map_grid_offset(dst_x, dst_y)] != 0;
 }
 
@@ -4,3 +4,4 @@ grid_i8 terrain_land_citizen;
 grid_i8 terrain_land_noncitizen;
 grid_i8 terrain_water;
 grid_i8 terrain_walls;
+passable_grid terrain_passable[PASSABLE_MAX];
@@ -3,6 +3,8 @@
 
 #include "map/grid.h"
 
+#include <stdint.h>
+
 enum {
     CITIZEN_0_ROAD = 0,
     CITIZEN_1_HIGHWAY = 1,
@@ -29,9 +31,32 @@ enum {
     WALL_N1_BLOCKED = -1,
 };
 
+typedef enum {
+    PASSABLE_CITIZEN_LAND,
+    PASSABLE_CITIZEN_ROAD_GARDEN,
+    PASSABLE_CITIZEN_ROAD_GARDEN_HIGHWAY,
+    PASSABLE_NONCITIZEN_LAND,
+    PASSABLE_NONCITIZEN_THROUGH_EVERYTHING,
+    PASSABLE_WALLS,
+    PASSABLE_MAX
+} passable_usage;
+
+#define PASSABLE_WORDS ((GRID_SIZE * GRID_SIZE + 63) / 64)
+
+// One bit per grid offset, rebuilt together with the terrain grid it is derived from
+typedef struct {
+    uint64_t words[PASSABLE_WORDS];
+} passable_grid;
+
 extern grid_i8 terrain_land_citizen;
 extern grid_i8 terrain_land_noncitizen;
 extern grid_i8 terrain_water;
 extern grid_i8 terrain_walls;
+extern passable_grid terrain_passable[PASSABLE_MAX];
+
+static inline int map_routing_passable_at(const passable_grid *passable, int grid_offset)
+{
+    return (passable->words[grid_offset >> 6] >> (grid_offset & 63)) & 1;
+}
 
 #endif // MAP_ROUTING_DATA_H
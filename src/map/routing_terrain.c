@@ -9,12 +9,55 @@
 #include "map/image.h"
 #include "map/property.h"
 #include "map/random.h"
+#include "map/road_network.h"
 #include "map/routing_data.h"
 #include "map/sprite.h"
 #include "map/terrain.h"
 
+#include <string.h>
+
 static void map_routing_update_land_noncitizen(void);
 
+static int land_revision;
+
+static int is_passable(passable_usage usage, int grid_offset)
+{
+    switch (usage) {
+        case PASSABLE_CITIZEN_LAND:
+            return terrain_land_citizen.items[grid_offset] >= CITIZEN_0_ROAD;
+        case PASSABLE_CITIZEN_ROAD_GARDEN:
+            return terrain_land_citizen.items[grid_offset] == CITIZEN_0_ROAD ||
+                terrain_land_citizen.items[grid_offset] == CITIZEN_2_PASSABLE_TERRAIN;
+        case PASSABLE_CITIZEN_ROAD_GARDEN_HIGHWAY:
+            return terrain_land_citizen.items[grid_offset] >= CITIZEN_0_ROAD &&
+                terrain_land_citizen.items[grid_offset] <= CITIZEN_2_PASSABLE_TERRAIN;
+        case PASSABLE_NONCITIZEN_LAND:
+            return (uint8_t) terrain_land_noncitizen.items[grid_offset] < NONCITIZEN_5_FORT;
+        case PASSABLE_NONCITIZEN_THROUGH_EVERYTHING:
+            return terrain_land_noncitizen.items[grid_offset] >= NONCITIZEN_0_PASSABLE;
+        case PASSABLE_WALLS:
+            return terrain_walls.items[grid_offset] >= WALL_0_PASSABLE && terrain_walls.items[grid_offset] <= 2;
+        default:
+            return 0;
+    }
+}
+
+static void update_passable(passable_usage first, passable_usage last)
+{
+    for (passable_usage usage = first; usage <= last; usage++) {
+        passable_grid *passable = &terrain_passable[usage];
+        memset(passable->words, 0, sizeof(passable->words));
+        int grid_offset = map_data.start_offset;
+        for (int y = 0; y < map_data.height; y++, grid_offset += map_data.border_size) {
+            for (int x = 0; x < map_data.width; x++, grid_offset++) {
+                if (is_passable(usage, grid_offset)) {
+                    passable->words[grid_offset >> 6] |= (uint64_t) 1 << (grid_offset & 63);
+                }
+            }
+        }
+    }
+}
+
 void map_routing_update_all(void)
 {
     map_routing_update_land();
@@ -101,6 +144,7 @@ static int get_land_type_citizen_aqueduct(int grid_offset)
 
 void map_routing_update_land_citizen(void)
 {
+    land_revision++;
     map_grid_init_i8(terrain_land_citizen.items, -1);
     int grid_offset = map_data.start_offset;
     for (int y = 0; y < map_data.height; y++, grid_offset += map_data.border_size) {
@@ -132,6 +176,8 @@ void map_routing_update_land_citizen(void)
             }
         }
     }
+    update_passable(PASSABLE_CITIZEN_LAND, PASSABLE_CITIZEN_ROAD_GARDEN_HIGHWAY);
+    map_road_network_check_changes();
 }
 
 static int get_land_type_noncitizen(int grid_offset)
@@ -210,6 +256,7 @@ static void map_routing_update_land_noncitizen(void)
             }
         }
     }
+    update_passable(PASSABLE_NONCITIZEN_LAND, PASSABLE_NONCITIZEN_THROUGH_EVERYTHING);
 }
 
 static int is_surrounded_by_water(int grid_offset)
@@ -303,6 +350,12 @@ void map_routing_update_walls(void)
             }
         }
     }
+    update_passable(PASSABLE_WALLS, PASSABLE_WALLS);
+}
+
+int map_routing_land_revision(void)
+{
+    return land_revision;
 }
 
 int map_routing_is_wall_passable(int grid_offset)
@@ -7,6 +7,12 @@ void map_routing_update_land_citizen(void);
 void map_routing_update_water(void);
 void map_routing_update_walls(void);
 
+/**
+ * Gets a counter that changes every time the citizen land routing grid is recalculated
+ * @return Land routing revision
+ */
+int map_routing_land_revision(void);
+
 int map_routing_is_wall_passable(int grid_offset);
 int map_routing_wall_tile_in_radius(int x, int y, int radius, int *x_wall, int *y_wall);
 
@@ -4,6 +4,14 @@
 
 static grid_u8 sprite;
 static grid_u8 sprite_backup;
+static grid_journal journal;
+
+static void save_for_restore(int grid_offset)
+{
+    if (map_grid_journal_add(&journal, grid_offset)) {
+        sprite_backup.items[grid_offset] = sprite.items[grid_offset];
+    }
+}
 
 int map_sprite_animation_at(int grid_offset)
 {
@@ -12,6 +20,7 @@ int map_sprite_animation_at(int grid_offset)
 
 void map_sprite_animation_set(int grid_offset, int value)
 {
+    save_for_restore(grid_offset);
     sprite.items[grid_offset] = value;
 }
 
@@ -22,37 +31,41 @@ int map_sprite_bridge_at(int grid_offset)
 
 void map_sprite_bridge_set(int grid_offset, int value)
 {
+    save_for_restore(grid_offset);
     sprite.items[grid_offset] = value;
 }
 
 void map_sprite_clear_tile(int grid_offset)
 {
+    save_for_restore(grid_offset);
     sprite.items[grid_offset] = 0;
 }
 
 void map_sprite_clear(void)
 {
     map_grid_clear_u8(sprite.items);
+    map_grid_journal_clear(&journal);
 }
 
 void map_sprite_backup(void)
 {
-    map_grid_copy_u8(sprite.items, sprite_backup.items);
+    map_grid_journal_clear(&journal);
 }
 
 void map_sprite_restore(void)
 {
-    map_grid_copy_u8(sprite_backup.items, sprite.items);
+    map_grid_journal_restore_u8(&journal, sprite_backup.items, sprite.items);
 }
 
 void map_sprite_save_state(buffer *buf, buffer *backup)
 {
     map_grid_save_state_u8(sprite.items, buf);
-    map_grid_save_state_u8(sprite_backup.items, backup);
+    map_grid_journal_save_state_u8(&journal, sprite.items, sprite_backup.items, backup);
 }
 
 void map_sprite_load_state(buffer *buf, buffer *backup)
 {
     map_grid_load_state_u8(sprite.items, buf);
     map_grid_load_state_u8(sprite_backup.items, backup);
+    map_grid_journal_rebuild_u8(&journal, sprite.items, sprite_backup.items);
 }
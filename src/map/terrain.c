@@ -9,9 +9,18 @@
 #include "map/ring.h"
 #include "map/routing.h"
 #include "map/sprite.h"
+#include "map/water_supply.h"
 
 static grid_u32 terrain_grid;
 static grid_u32 terrain_grid_backup;
+static grid_journal journal;
+
+static void save_for_restore(int grid_offset)
+{
+    if (map_grid_journal_add(&journal, grid_offset)) {
+        terrain_grid_backup.items[grid_offset] = terrain_grid.items[grid_offset];
+    }
+}
 
 int map_terrain_is(int grid_offset, int terrain)
 {
@@ -42,16 +51,32 @@ int map_terrain_get_from_buffer_32(buffer *buf, int grid_offset)
 
 void map_terrain_set(int grid_offset, int terrain)
 {
+    if ((terrain_grid.items[grid_offset] ^ terrain) & TERRAIN_AQUEDUCT) {
+        map_water_supply_invalidate_aqueducts();
+    }
+    if (terrain_grid.items[grid_offset] & ~terrain & (TERRAIN_RESERVOIR_RANGE | TERRAIN_FOUNTAIN_RANGE)) {
+        // the ranges are tracked by the water supply counts, so they outlive the rest of the tile
+        terrain |= map_water_supply_range_terrain(grid_offset);
+    }
+    save_for_restore(grid_offset);
     terrain_grid.items[grid_offset] = terrain;
 }
 
 void map_terrain_add(int grid_offset, int terrain)
 {
+    if (terrain & TERRAIN_AQUEDUCT) {
+        map_water_supply_invalidate_aqueducts();
+    }
+    save_for_restore(grid_offset);
     terrain_grid.items[grid_offset] |= terrain;
 }
 
 void map_terrain_remove(int grid_offset, int terrain)
 {
+    if (terrain & TERRAIN_AQUEDUCT) {
+        map_water_supply_invalidate_aqueducts();
+    }
+    save_for_restore(grid_offset);
     terrain_grid.items[grid_offset] &= ~terrain;
 }
 
@@ -81,7 +106,15 @@ void map_terrain_remove_with_radius(int x, int y, int size, int radius, int terr
 
 void map_terrain_remove_all(int terrain)
 {
-    map_grid_and_u32(terrain_grid.items, ~terrain);
+    if (terrain & TERRAIN_AQUEDUCT) {
+        map_water_supply_invalidate_aqueducts();
+    }
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+        if (terrain_grid.items[i] & terrain) {
+            save_for_restore(i);
+            terrain_grid.items[i] &= ~terrain;
+        }
+    }
 }
 
 int map_terrain_count_directly_adjacent_with_type(int grid_offset, int terrain)
@@ -397,17 +430,20 @@ void map_terrain_add_triumphal_arch_roads(int x, int y, int orientation)
 
 void map_terrain_backup(void)
 {
-    map_grid_copy_u32(terrain_grid.items, terrain_grid_backup.items);
+    map_grid_journal_clear(&journal);
 }
 
 void map_terrain_restore(void)
 {
-    map_grid_copy_u32(terrain_grid_backup.items, terrain_grid.items);
+    map_grid_journal_restore_u32(&journal, terrain_grid_backup.items, terrain_grid.items);
+    map_water_supply_clear();
 }
 
 void map_terrain_clear(void)
 {
     map_grid_clear_u32(terrain_grid.items);
+    map_grid_journal_clear(&journal);
+    map_water_supply_clear();
 }
 
 void map_terrain_init_outside_map(void)
@@ -577,4 +613,6 @@ void map_terrain_load_state(buffer *buf, int expanded_terrain_data, buffer *imag
         map_grid_load_state_u16_to_u32(terrain_grid.items, buf);
     }
     determine_original_trees(images, legacy_image_buffer);
+    map_grid_journal_clear(&journal);
+    map_water_supply_clear();
 }
@@ -5,7 +5,9 @@
 #include "building/image.h"
 #include "building/monument.h"
 #include "building/list.h"
+#include "core/array.h"
 #include "core/image.h"
+#include "core/log.h"
 #include "map/aqueduct.h"
 #include "map/building_tiles.h"
 #include "map/data.h"
@@ -22,48 +24,162 @@
 
 #define OFFSET(x,y) (x + GRID_SIZE * y)
 
-#define MAX_QUEUE 1000
 #define RESERVOIR_RADIUS 10
 #define WELL_RADIUS 2
 #define LATRINES_RADIUS 3
 #define FOUNTAIN_RADIUS 4
+#define COVERAGE_SOURCES_ARRAY_SIZE_STEP 64
 
 static const int ADJACENT_OFFSETS[] = { -GRID_SIZE, 1, GRID_SIZE, -1 };
 static const int CONNECTOR_OFFSETS[] = { OFFSET(1,-1), OFFSET(3,1), OFFSET(1,3), OFFSET(-1,1) };
 
+typedef struct {
+    unsigned int id;
+    int in_use;
+    int building_id;
+    int x;
+    int y;
+    int size;
+    int radius;
+    int last_update;
+} coverage_source;
+
+// Keeps a count of how many sources cover each tile, so that adding or removing a source
+// only touches its own range instead of the whole map
+typedef struct {
+    grid_u8 count;
+    grid_u16 source_index;
+    array(coverage_source) sources;
+    int terrain;
+    int update_id;
+} coverage;
+
 static struct {
-    int items[MAX_QUEUE];
-    int head;
-    int tail;
-} queue;
+    grid_u16 segment;
+    int segment_start[GRID_SIZE * GRID_SIZE + 1];
+    int tiles[GRID_SIZE * GRID_SIZE];
+    uint8_t has_water[GRID_SIZE * GRID_SIZE];
+    int8_t applied_water[GRID_SIZE * GRID_SIZE];
+    int total_segments;
+    int needs_relabel;
+    int needs_full_update;
+    int needs_buildings_update;
+} aqueducts = { .needs_relabel = 1, .needs_full_update = 1, .needs_buildings_update = 1 };
+
+static coverage reservoir_range = { .terrain = TERRAIN_RESERVOIR_RANGE };
+static coverage fountain_range = { .terrain = TERRAIN_FOUNTAIN_RANGE };
+static coverage well_range;
+static coverage latrines_range;
+
+static void new_coverage_source(coverage_source *source, unsigned int position)
+{
+    source->id = position;
+}
+
+static int coverage_source_in_use(const coverage_source *source)
+{
+    return source->in_use;
+}
 
-static void mark_well_access(int well_id, int radius)
+static void reset_coverage(coverage *c)
+{
+    map_grid_clear_u8(c->count.items);
+    map_grid_clear_u16(c->source_index.items);
+    if (!array_init(c->sources, COVERAGE_SOURCES_ARRAY_SIZE_STEP, new_coverage_source, coverage_source_in_use)) {
+        log_error("Unable to allocate enough memory for the water coverage sources. The game will likely crash.", 0, 0);
+    }
+}
+
+static void change_coverage(coverage *c, const coverage_source *source, int delta)
 {
-    building *well = building_get(well_id);
     int x_min, y_min, x_max, y_max;
-    map_grid_get_area(well->x, well->y, 1, radius, &x_min, &y_min, &x_max, &y_max);
+    map_grid_get_area(source->x, source->y, source->size, source->radius, &x_min, &y_min, &x_max, &y_max);
 
     for (int yy = y_min; yy <= y_max; yy++) {
         for (int xx = x_min; xx <= x_max; xx++) {
-            int building_id = map_building_at(map_grid_offset(xx, yy));
-            if (building_id) {
-                building_get(building_id)->has_well_access = 1;
+            int grid_offset = map_grid_offset(xx, yy);
+            if (delta > 0) {
+                if (!c->count.items[grid_offset]++ && c->terrain) {
+                    map_terrain_add(grid_offset, c->terrain);
+                }
+            } else if (c->count.items[grid_offset]) {
+                if (!--c->count.items[grid_offset] && c->terrain) {
+                    map_terrain_remove(grid_offset, c->terrain);
+                }
+            }
+        }
+    }
+}
+
+static void start_coverage_update(coverage *c)
+{
+    c->update_id++;
+}
+
+static void set_coverage_source(coverage *c, const building *b, int size, int radius)
+{
+    coverage_source *source;
+    int index = c->source_index.items[b->grid_offset];
+    if (index) {
+        source = array_item(c->sources, index - 1);
+        if (source->building_id == b->id && source->x == b->x && source->y == b->y &&
+            source->size == size && source->radius == radius) {
+            source->last_update = c->update_id;
+            return;
+        }
+        change_coverage(c, source, -1);
+    } else {
+        array_new_item(c->sources, source);
+        if (!source) {
+            return;
+        }
+        c->source_index.items[b->grid_offset] = source->id + 1;
+    }
+    source->in_use = 1;
+    source->building_id = b->id;
+    source->x = b->x;
+    source->y = b->y;
+    source->size = size;
+    source->radius = radius;
+    source->last_update = c->update_id;
+    change_coverage(c, source, 1);
+}
+
+static void finish_coverage_update(coverage *c)
+{
+    coverage_source *source;
+    array_foreach(c->sources, source) {
+        if (source->in_use && source->last_update != c->update_id) {
+            change_coverage(c, source, -1);
+            c->source_index.items[map_grid_offset(source->x, source->y)] = 0;
+            source->in_use = 0;
+        }
+    }
+    array_trim(c->sources);
+}
+
+static int has_coverage_in_area(const coverage *c, int x, int y, int size)
+{
+    for (int yy = y; yy < y + size; yy++) {
+        for (int xx = x; xx < x + size; xx++) {
+            if (c->count.items[map_grid_offset(xx, yy)]) {
+                return 1;
             }
         }
     }
+    return 0;
 }
 
-static void mark_latrines_access(int latrines_id, int radius)
+static void mark_well_access(const building *well, int radius)
 {
-    building *latrines = building_get(latrines_id);
     int x_min, y_min, x_max, y_max;
-    map_grid_get_area(latrines->x, latrines->y, 1, radius, &x_min, &y_min, &x_max, &y_max);
+    map_grid_get_area(well->x, well->y, 1, radius, &x_min, &y_min, &x_max, &y_max);
 
     for (int yy = y_min; yy <= y_max; yy++) {
         for (int xx = x_min; xx <= x_max; xx++) {
             int building_id = map_building_at(map_grid_offset(xx, yy));
-            if (building_id && latrines->num_workers > 0) {
-                building_get(building_id)->has_latrines_access = 1;
+            if (building_id) {
+                building_get(building_id)->has_well_access = 1;
             }
         }
     }
@@ -71,55 +187,111 @@ static void mark_latrines_access(int latrines_id, int radius)
 
 void map_water_supply_update_buildings(void)
 {
+    if (aqueducts.needs_buildings_update) {
+        reset_coverage(&well_range);
+        reset_coverage(&latrines_range);
+        aqueducts.needs_buildings_update = 0;
+    }
+    start_coverage_update(&well_range);
+    int well_radius = map_water_supply_well_radius();
+    for (building *b = building_first_of_type(BUILDING_WELL); b; b = b->next_of_type) {
+        if (b->state == BUILDING_STATE_IN_USE) {
+            set_coverage_source(&well_range, b, 1, well_radius);
+        }
+    }
+    finish_coverage_update(&well_range);
+
+    start_coverage_update(&latrines_range);
+    int latrines_radius = map_water_supply_latrines_radius();
+    for (building *b = building_first_of_type(BUILDING_LATRINES); b; b = b->next_of_type) {
+        if (b->state == BUILDING_STATE_IN_USE && b->num_workers > 0) {
+            set_coverage_source(&latrines_range, b, 1, latrines_radius);
+        }
+    }
+    finish_coverage_update(&latrines_range);
+
     for (building_type type = BUILDING_HOUSE_SMALL_TENT; type <= BUILDING_HOUSE_LUXURY_PALACE; type++) {
         for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
             if (b->state != BUILDING_STATE_IN_USE || !b->house_size) {
                 continue;
             }
-            b->has_water_access = 0;
-            b->has_well_access = 0;
-            b->has_latrines_access = 0;
-            if (map_terrain_exists_tile_in_area_with_type(
-                b->x, b->y, b->size, TERRAIN_FOUNTAIN_RANGE)) {
-                b->has_water_access = 1;
-            }
+            b->has_water_access = map_terrain_exists_tile_in_area_with_type(
+                b->x, b->y, b->size, TERRAIN_FOUNTAIN_RANGE);
+            b->has_well_access = has_coverage_in_area(&well_range, b->x, b->y, b->size);
+            b->has_latrines_access = has_coverage_in_area(&latrines_range, b->x, b->y, b->size);
         }
     }
 
     for (building *b = building_first_of_type(BUILDING_CONCRETE_MAKER); b; b = b->next_of_type) {
-        b->has_well_access = 0;
+        b->has_well_access = has_coverage_in_area(&well_range, b->x, b->y, b->size);
     }
 
+    // the water overlay shows well access for every kind of building
     for (building *b = building_first_of_type(BUILDING_WELL); b; b = b->next_of_type) {
         if (b->state == BUILDING_STATE_IN_USE) {
-            mark_well_access(b->id, map_water_supply_well_radius());
+            mark_well_access(b, well_radius);
         }
     }
+}
 
-    for (building *b = building_first_of_type(BUILDING_LATRINES); b; b = b->next_of_type) {
-        if (b->state == BUILDING_STATE_IN_USE) {
-            mark_latrines_access(b->id, map_water_supply_latrines_radius());
-        }
+void map_water_supply_invalidate_aqueducts(void)
+{
+    aqueducts.needs_relabel = 1;
+}
+
+int map_water_supply_range_terrain(int grid_offset)
+{
+    if (aqueducts.needs_full_update) {
+        return 0;
+    }
+    int terrain = 0;
+    if (reservoir_range.count.items[grid_offset]) {
+        terrain |= reservoir_range.terrain;
     }
+    if (fountain_range.count.items[grid_offset]) {
+        terrain |= fountain_range.terrain;
+    }
+    return terrain;
 }
 
-static void set_all_aqueducts_to_no_water(void)
+void map_water_supply_clear(void)
 {
+    aqueducts.needs_relabel = 1;
+    aqueducts.needs_full_update = 1;
+    aqueducts.needs_buildings_update = 1;
+}
+
+static void label_aqueduct_segments(void)
+{
+    map_grid_clear_u16(aqueducts.segment.items);
+    int total_tiles = 0;
+    int total_segments = 0;
     int grid_offset = map_data.start_offset;
     for (int y = 0; y < map_data.height; y++, grid_offset += map_data.border_size) {
         for (int x = 0; x < map_data.width; x++, grid_offset++) {
-            if (map_terrain_is(grid_offset, TERRAIN_AQUEDUCT)) {
-                map_aqueduct_set_water_access(grid_offset, 0);
-                int image_id = map_image_at(grid_offset);
-                if (image_id < image_group(GROUP_BUILDING_AQUEDUCT_NO_WATER)) {
-                    map_image_set(grid_offset, image_id + 15);
-                } else if(map_terrain_is(grid_offset, TERRAIN_HIGHWAY)) {
-                    image_id = map_tiles_highway_get_aqueduct_image(grid_offset);
-                    map_image_set(grid_offset, image_id);
+            if (!map_terrain_is(grid_offset, TERRAIN_AQUEDUCT) || aqueducts.segment.items[grid_offset]) {
+                continue;
+            }
+            // Segment ids start at 1 so that 0 means "no aqueduct"
+            int segment = ++total_segments;
+            aqueducts.segment_start[segment] = total_tiles;
+            aqueducts.applied_water[segment] = -1;
+            aqueducts.segment.items[grid_offset] = segment;
+            aqueducts.tiles[total_tiles++] = grid_offset;
+            for (int n = aqueducts.segment_start[segment]; n < total_tiles; n++) {
+                for (int i = 0; i < 4; i++) {
+                    int new_offset = aqueducts.tiles[n] + ADJACENT_OFFSETS[i];
+                    if (map_terrain_is(new_offset, TERRAIN_AQUEDUCT) && !aqueducts.segment.items[new_offset]) {
+                        aqueducts.segment.items[new_offset] = segment;
+                        aqueducts.tiles[total_tiles++] = new_offset;
+                    }
                 }
             }
         }
     }
+    aqueducts.segment_start[total_segments + 1] = total_tiles;
+    aqueducts.total_segments = total_segments;
+    aqueducts.needs_relabel = 0;
 }
 
 static int is_valid_reservoir_connection(int grid_offset)
@@ -128,72 +300,58 @@ static int is_valid_reservoir_connection(int grid_offset)
     return xy != EDGE_X0Y0 && xy != EDGE_X2Y0 && xy != EDGE_X0Y2 && xy != EDGE_X2Y2;
 }
 
-static void fill_aqueducts_from_offset(int grid_offset)
+static void set_segment_water_access(int segment, int has_water)
 {
-    if (!map_terrain_is(grid_offset, TERRAIN_AQUEDUCT)) {
+    for (int n = aqueducts.segment_start[segment]; n < aqueducts.segment_start[segment + 1]; n++) {
+        int grid_offset = aqueducts.tiles[n];
+        map_aqueduct_set_water_access(grid_offset, has_water);
+        int image_id = map_image_at(grid_offset);
+        if (map_terrain_is(grid_offset, TERRAIN_HIGHWAY)) {
+            map_image_set(grid_offset, map_tiles_highway_get_aqueduct_image(grid_offset));
+        } else if (has_water && image_id >= image_group(GROUP_BUILDING_AQUEDUCT_NO_WATER)) {
+            map_image_set(grid_offset, image_id - 15);
+        } else if (!has_water && image_id < image_group(GROUP_BUILDING_AQUEDUCT_NO_WATER)) {
+            map_image_set(grid_offset, image_id + 15);
+        }
+    }
+    aqueducts.applied_water[segment] = has_water;
+}
+
+static void fill_from_reservoir(building *reservoir)
+{
+    for (int d = 0; d < 4; d++) {
+        int grid_offset = reservoir->grid_offset + CONNECTOR_OFFSETS[d];
+        int segment = aqueducts.segment.items[grid_offset];
+        if (segment) {
+            aqueducts.has_water[segment] = 1;
+            continue;
+        }
         building *b = building_get(map_building_at(grid_offset));
         if (b->id && b->type == BUILDING_RESERVOIR) {
             if (!b->has_water_access && is_valid_reservoir_connection(grid_offset)) {
                 b->has_water_access = 2;
             }
         }
-        return;
     }
-    memset(&queue, 0, sizeof(queue));
-    int guard = 0;
-    int next_offset;
+}
 
-    do {
-        if (++guard >= GRID_SIZE * GRID_SIZE) {
-            break;
-        }
-        map_aqueduct_set_water_access(grid_offset, 1);
-        int image_id = map_image_at(grid_offset);
-        if (map_terrain_is(grid_offset, TERRAIN_HIGHWAY)) {
-            image_id = map_tiles_highway_get_aqueduct_image(grid_offset);
-            map_image_set(grid_offset, image_id);
-        } else if (image_id >= image_group(GROUP_BUILDING_AQUEDUCT_NO_WATER)) {
-            map_image_set(grid_offset, image_id - 15);
-        }
-        next_offset = -1;
-        for (int i = 0; i < 4; i++) {
-            int new_offset = grid_offset + ADJACENT_OFFSETS[i];
-            building *b = building_get(map_building_at(new_offset));
-            if (b->id && b->type == BUILDING_RESERVOIR) {
-                if (!b->has_water_access && is_valid_reservoir_connection(new_offset)) {
-                    b->has_water_access = 2;
-                }
-            } else if (map_terrain_is(new_offset, TERRAIN_AQUEDUCT)) {
-                if (!map_aqueduct_has_water_access_at(new_offset)) {
-                    if (next_offset == -1) {
-                        next_offset = new_offset;
-                    } else {
-                        queue.items[queue.tail++] = new_offset;
-                        if (queue.tail >= MAX_QUEUE) {
-                            queue.tail = 0;
-                        }
-                    }
-                }
-            }
-        }
-        if (next_offset == -1) {
-            if (queue.head == queue.tail) {
-                return;
-            }
-            next_offset = queue.items[queue.head++];
-            if (queue.head >= MAX_QUEUE) {
-                queue.head = 0;
-            }
+static int is_filled_by_aqueduct(const building *reservoir)
+{
+    for (int d = 0; d < 4; d++) {
+        int segment = aqueducts.segment.items[reservoir->grid_offset + CONNECTOR_OFFSETS[d]];
+        if (segment && aqueducts.has_water[segment]) {
+            return 1;
         }
-        grid_offset = next_offset;
-    } while (next_offset > -1);
+    }
+    return 0;
 }
 
-void map_water_supply_update_reservoir_fountain(void)
+static void update_aqueducts(void)
 {
-    map_terrain_remove_all(TERRAIN_FOUNTAIN_RANGE | TERRAIN_RESERVOIR_RANGE);
-    // reservoirs
-    set_all_aqueducts_to_no_water();
+    if (aqueducts.needs_relabel) {
+        label_aqueduct_segments();
+    }
+    memset(aqueducts.has_water, 0, (aqueducts.total_segments + 1) * sizeof(uint8_t));
     for (building *b = building_first_of_type(BUILDING_RESERVOIR); b; b = b->next_of_type) {
         if (b->state != BUILDING_STATE_IN_USE) {
             continue;
@@ -204,7 +362,7 @@ void map_water_supply_update_reservoir_fountain(void)
             b->has_water_access = 0;
         }
     }
-    // fill reservoirs from full ones
+    // fill reservoirs from full ones, going through whole aqueduct segments at once
     int changed = 1;
     while (changed == 1) {
         changed = 0;
@@ -212,29 +370,58 @@ void map_water_supply_update_reservoir_fountain(void)
             if (b->state != BUILDING_STATE_IN_USE) {
                 continue;
             }
+            if (!b->has_water_access && is_filled_by_aqueduct(b)) {
+                b->has_water_access = 2;
+            }
             if (b->has_water_access == 2) {
                 b->has_water_access = 1;
                 changed = 1;
-                for (int d = 0; d < 4; d++) {
-                    fill_aqueducts_from_offset(b->grid_offset + CONNECTOR_OFFSETS[d]);
-                }
+                fill_from_reservoir(b);
             }
         }
     }
+    // only the segments whose water state changed need their tiles updated
+    for (int segment = 1; segment <= aqueducts.total_segments; segment++) {
+        if (aqueducts.applied_water[segment] != aqueducts.has_water[segment]) {
+            set_segment_water_access(segment, aqueducts.has_water[segment]);
+        }
+    }
+}
+
+void map_water_supply_update_reservoir_fountain(void)
+{
+    if (aqueducts.needs_full_update) {
+        // terrain may have been replaced wholesale: rebuild the ranges from scratch
+        map_terrain_remove_all(TERRAIN_FOUNTAIN_RANGE | TERRAIN_RESERVOIR_RANGE);
+        reset_coverage(&reservoir_range);
+        reset_coverage(&fountain_range);
+        aqueducts.needs_relabel = 1;
+        aqueducts.needs_full_update = 0;
+    }
+    // reservoirs
+    update_aqueducts();
+
     // mark reservoir ranges
+    start_coverage_update(&reservoir_range);
+    int reservoir_radius = map_water_supply_reservoir_radius();
     for (building *b = building_first_of_type(BUILDING_RESERVOIR); b; b = b->next_of_type) {
         if (b->state == BUILDING_STATE_IN_USE && b->has_water_access) {
-            map_terrain_add_with_radius(b->x, b->y, 3, map_water_supply_reservoir_radius(), TERRAIN_RESERVOIR_RANGE);
+            set_coverage_source(&reservoir_range, b, 3, reservoir_radius);
         }
     }
 
     // Neptune GT module 2 bonus
     if (building_monument_gt_module_is_active(NEPTUNE_MODULE_2_CAPACITY_AND_WATER)) {
         building *b = building_get(building_monument_get_neptune_gt());
-        map_terrain_add_with_radius(b->x, b->y, 7, map_water_supply_reservoir_radius(), TERRAIN_RESERVOIR_RANGE);
+        if (b->id) {
+            set_coverage_source(&reservoir_range, b, 7, reservoir_radius);
+        }
     }
+    finish_coverage_update(&reservoir_range);
 
     // fountains
+    start_coverage_update(&fountain_range);
+    int fountain_radius = map_water_supply_fountain_radius();
     for (building *b = building_first_of_type(BUILDING_FOUNTAIN); b; b = b->next_of_type) {
         if (b->state != BUILDING_STATE_IN_USE) {
             continue;
@@ -251,12 +438,13 @@ void map_water_supply_update_reservoir_fountain(void)
         map_building_tiles_add(b->id, b->x, b->y, 1, building_image_get(b), TERRAIN_BUILDING);
         if (map_terrain_is(b->grid_offset, TERRAIN_RESERVOIR_RANGE) && b->num_workers) {
             b->has_water_access = 1;
-            map_terrain_add_with_radius(b->x, b->y, 1,
-                map_water_supply_fountain_radius(), TERRAIN_FOUNTAIN_RANGE);
+            set_coverage_source(&fountain_range, b, 1, fountain_radius);
         } else {
             b->has_water_access = 0;
         }
     }
+    finish_coverage_update(&fountain_range);
+
     // Ponds
     static const building_type ponds[] = { BUILDING_SMALL_POND, BUILDING_LARGE_POND };
     for (int i = 0; i < 2; i++) {
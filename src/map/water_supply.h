@@ -5,6 +5,26 @@ void map_water_supply_update_buildings(void);
 void map_water_supply_update_reservoir_fountain(void);
 int map_water_supply_has_aqueduct_access(int grid_offset);
 
+/**
+ * Marks the aqueduct segments as outdated, to be relabelled on the next water supply update.
+ * Called whenever an aqueduct tile is added or removed.
+ */
+void map_water_supply_invalidate_aqueducts(void);
+
+/**
+ * Gets the reservoir and fountain range terrain that the current water sources give a tile.
+ * Used to keep those flags when the rest of the tile's terrain is replaced.
+ * @param grid_offset Tile to check
+ * @return The range terrain flags that cover the tile
+ */
+int map_water_supply_range_terrain(int grid_offset);
+
+/**
+ * Discards all water supply state, forcing a full update of aqueducts and ranges.
+ * Called when the terrain is replaced as a whole, like on load or undo.
+ */
+void map_water_supply_clear(void);
+
 enum {
     BUILDING_NECESSARY = 0,
     BUILDING_UNNECESSARY_FOUNTAIN = 1,
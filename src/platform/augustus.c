@@ -1,6 +1,7 @@
 #include "SDL.h"
 
 #include "core/config.h"
+#include "core/dir.h"
 #include "core/encoding.h"
 #include "core/file.h"
 #include "core/lang.h"
@@ -267,6 +268,8 @@ static void handle_window_event(SDL_WindowEvent *event, int *window_active)
 #ifdef USE_FILE_CACHE
             platform_file_manager_cache_invalidate();
 #endif
+            // Files may have been changed while the window was hidden
+            dir_invalidate_cache();
             *window_active = 1;
             break;
         case SDL_WINDOWEVENT_HIDDEN:
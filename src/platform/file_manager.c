@@ -2,6 +2,7 @@
 
 #include "assets/assets.h"
 #include "core/config.h"
+#include "core/dir.h"
 #include "core/file.h"
 #include "core/log.h"
 #include "core/random.h"
@@ -501,6 +502,7 @@ int platform_file_manager_set_base_path(const char *path)
         return 0;
     }
 #ifdef __ANDROID__
+    dir_invalidate_cache();
     return android_set_base_path(path);
 #else
     const file_name *set_path = set_file_name(path);
@@ -510,6 +512,7 @@ int platform_file_manager_set_base_path(const char *path)
 #ifdef USE_FILE_CACHE
         platform_file_manager_cache_invalidate();
 #endif
+        dir_invalidate_cache();
         return 1;
     }
     return 0;
@@ -615,6 +618,9 @@ int platform_file_manager_is_directory_writeable(const char *directory)
 
 FILE *platform_file_manager_open_file(const char *filename, const char *mode)
 {
+    if (strchr(mode, 'w') || strchr(mode, 'a')) {
+        dir_invalidate_cache();
+    }
     int fd = android_get_file_descriptor(filename, mode);
     if (!fd) {
         return NULL;
@@ -629,6 +635,7 @@ FILE *platform_file_manager_open_asset(const char *asset, const char *mode)
 
 int platform_file_manager_remove_file(const char *filename)
 {
+    dir_invalidate_cache();
     return android_remove_file(filename);
 }
 
@@ -641,6 +648,9 @@ FILE *platform_file_manager_open_file(const char *filename, const char *mode)
         platform_file_manager_cache_update_file_info(filename);
     }
 #endif
+    if (strchr(mode, 'w') || strchr(mode, 'a')) {
+        dir_invalidate_cache();
+    }
 
 #if defined(__EMSCRIPTEN__)
     writing_to_file = strchr(mode, 'w') != 0;
@@ -662,6 +672,7 @@ int platform_file_manager_remove_file(const char *filename)
 #ifdef USE_FILE_CACHE
     platform_file_manager_cache_delete_file_info(filename);
 #endif
+    dir_invalidate_cache();
     const file_name *wfile = set_file_name(filename);
     int result = fs_remove(wfile);
     free_file_name(wfile);
@@ -702,6 +713,7 @@ int platform_file_manager_create_directory(const char *name, const char *locatio
     char temporary_path[FILE_NAME_MAX] = { 0 };
     int overwrite_last = 0;
     int cursor = 0;
+    dir_invalidate_cache();
     if (location) {
         cursor = snprintf(temporary_path, FILE_NAME_MAX, "%s", location);
         if (cursor > FILE_NAME_MAX) {
@@ -949,6 +961,7 @@ static int remove_directory(const char *name, long unused)
 
 int platform_file_manager_remove_directory(const char *path)
 {
+    dir_invalidate_cache();
     copy_directory_name(path, directory_copy_data.current_src_path);
     return remove_directory(0, 0);
 }
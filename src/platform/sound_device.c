@@ -27,6 +27,10 @@
 
 #define NO_CHANNEL -1
 
+#define MAX_CACHED_CHUNKS 64
+#define MAX_CACHED_CHUNK_BYTES (24 * 1024 * 1024)
+#define MAX_PRELOAD_FILES 32
+
 #if SDL_VERSION_ATLEAST(2, 0, 7)
 #define USE_SDL_AUDIOSTREAM
 #endif
@@ -46,6 +50,25 @@ typedef struct {
     time_millis last_played;
 } sound_channel;
 
+typedef struct {
+    char filename[FILE_NAME_MAX];
+    Mix_Chunk *chunk;
+    time_millis last_used;
+} cached_chunk;
+
+static struct {
+    cached_chunk items[MAX_CACHED_CHUNKS];
+    int total;
+    size_t total_bytes;
+    char campaign_name[FILE_NAME_MAX];
+} chunk_cache;
+
+static struct {
+    char filenames[MAX_PRELOAD_FILES][FILE_NAME_MAX];
+    int head;
+    int total;
+} preload;
+
 static struct {
     int initialized;
     uint8_t *custom_music;
@@ -156,22 +179,34 @@ static void stop_channel(int channel)
     }
     sound_channel *ch = &data.channels[channel];
     if (ch->chunk) {
+        // The chunk itself is owned by the chunk cache
         Mix_HaltChannel(channel);
-        Mix_FreeChunk(ch->chunk);
         ch->chunk = 0;
     }
     ch->filename[0] = 0;
     ch->last_played = 0;
 }
 
+static void clear_chunk_cache(void)
+{
+    for (int i = 0; i < data.total_channels; i++) {
+        stop_channel(i);
+    }
+    for (int i = 0; i < chunk_cache.total; i++) {
+        Mix_FreeChunk(chunk_cache.items[i].chunk);
+    }
+    chunk_cache.total = 0;
+    chunk_cache.total_bytes = 0;
+    preload.head = 0;
+    preload.total = 0;
+}
+
 void sound_device_close(void)
 {
     if (!data.initialized) {
         return;
     }
-    for (int i = 0; i < data.total_channels; i++) {
-        stop_channel(i);
-    }
+    clear_chunk_cache();
     Mix_ChannelFinished(NULL);
     Mix_CloseAudio();
     free(data.channels);
@@ -207,6 +242,120 @@ static Mix_Chunk *load_chunk(const char *filename)
 #endif
 }
 
+static int chunk_is_playing(const Mix_Chunk *chunk)
+{
+    for (int i = 0; i < data.total_channels; i++) {
+        if (data.channels[i].chunk == chunk && Mix_Playing(i)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void remove_cached_chunk(int index)
+{
+    cached_chunk *item = &chunk_cache.items[index];
+    for (int i = 0; i < data.total_channels; i++) {
+        if (data.channels[i].chunk == item->chunk) {
+            stop_channel(i);
+        }
+    }
+    chunk_cache.total_bytes -= item->chunk->alen;
+    Mix_FreeChunk(item->chunk);
+    chunk_cache.total--;
+    if (index != chunk_cache.total) {
+        *item = chunk_cache.items[chunk_cache.total];
+    }
+}
+
+static int evict_least_recently_used_chunk(void)
+{
+    int oldest = -1;
+    for (int i = 0; i < chunk_cache.total; i++) {
+        if (chunk_is_playing(chunk_cache.items[i].chunk)) {
+            continue;
+        }
+        if (oldest == -1 || chunk_cache.items[i].last_used < chunk_cache.items[oldest].last_used) {
+            oldest = i;
+        }
+    }
+    if (oldest == -1) {
+        return 0;
+    }
+    remove_cached_chunk(oldest);
+    return 1;
+}
+
+static void check_campaign_change(void)
+{
+    // Campaigns can override sound files, so cached chunks are only valid for the campaign they were loaded for
+    const char *campaign_name = game_campaign_is_active() ? game_campaign_get_name() : "";
+    if (!campaign_name) {
+        campaign_name = "";
+    }
+    if (strcmp(campaign_name, chunk_cache.campaign_name) != 0) {
+        clear_chunk_cache();
+        snprintf(chunk_cache.campaign_name, FILE_NAME_MAX, "%s", campaign_name);
+    }
+}
+
+static Mix_Chunk *get_chunk(const char *filename)
+{
+    if (!filename || !*filename) {
+        return 0;
+    }
+    check_campaign_change();
+    for (int i = 0; i < chunk_cache.total; i++) {
+        if (strcmp(chunk_cache.items[i].filename, filename) == 0) {
+            chunk_cache.items[i].last_used = time_get_millis();
+            return chunk_cache.items[i].chunk;
+        }
+    }
+    Mix_Chunk *chunk = load_chunk(filename);
+    if (!chunk) {
+        return 0;
+    }
+    while (chunk_cache.total == MAX_CACHED_CHUNKS ||
+        (chunk_cache.total && chunk_cache.total_bytes + chunk->alen > MAX_CACHED_CHUNK_BYTES)) {
+        if (!evict_least_recently_used_chunk()) {
+            break;
+        }
+    }
+    if (chunk_cache.total == MAX_CACHED_CHUNKS) {
+        // Every cached chunk is still playing, so there is no room to keep this one
+        Mix_FreeChunk(chunk);
+        return 0;
+    }
+    cached_chunk *item = &chunk_cache.items[chunk_cache.total++];
+    snprintf(item->filename, FILE_NAME_MAX, "%s", filename);
+    item->chunk = chunk;
+    item->last_used = time_get_millis();
+    chunk_cache.total_bytes += chunk->alen;
+    return chunk;
+}
+
+void sound_device_preload_file(const char *filename)
+{
+    if (!data.initialized || !filename || !*filename || preload.total == MAX_PRELOAD_FILES) {
+        return;
+    }
+    int index = (preload.head + preload.total) % MAX_PRELOAD_FILES;
+    snprintf(preload.filenames[index], FILE_NAME_MAX, "%s", filename);
+    preload.total++;
+}
+
+void sound_device_process_preloads(void)
+{
+    if (!data.initialized || !preload.total || !config_get(CONFIG_GENERAL_ENABLE_AUDIO)) {
+        return;
+    }
+    // Only one file per call, so that preloading never stalls a single frame
+    const char *filename = preload.filenames[preload.head];
+    preload.head = (preload.head + 1) % MAX_PRELOAD_FILES;
+    preload.total--;
+    get_chunk(filename);
+}
+
 static void callback_for_audio_finished(int channel)
 {
     if (!data.sound_finished_callback) {
@@ -276,7 +425,7 @@ void sound_device_set_volume_for_type(sound_type type, int volume_pct)
     for (int i = 0; i < sound_type_to_channels[type].total; i++) {
         int channel = i + sound_type_to_channels[type].start;
         if (data.channels[channel].chunk) {
-            Mix_VolumeChunk(data.channels[channel].chunk, percentage_to_volume(volume_pct));
+            Mix_Volume(channel, percentage_to_volume(volume_pct));
         }
     }
 }
@@ -437,14 +586,16 @@ int sound_device_play_file_on_channel_panned(const char *filename, sound_type ty
             return 0;
         }
         stop_channel(channel);
-        data.channels[channel].chunk = load_chunk(filename);
-        if (!data.channels[channel].chunk) {
+        Mix_Chunk *chunk = get_chunk(filename);
+        if (!chunk) {
             return 0;
         }
+        data.channels[channel].chunk = chunk;
         snprintf(data.channels[channel].filename, FILE_NAME_MAX, "%s", filename);
     }
     Mix_SetPanning(channel, left_pct * 255 / 100, right_pct * 255 / 100);
-    Mix_VolumeChunk(data.channels[channel].chunk, percentage_to_volume(volume_pct));
+    // Chunks are shared between channels, so the volume is set on the channel instead of the chunk
+    Mix_Volume(channel, percentage_to_volume(volume_pct));
     int result = Mix_PlayChannel(channel, data.channels[channel].chunk, loop ? -1 : 0); // -1 = loop
     if (result == -1) {
         return 0;
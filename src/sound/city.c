@@ -148,6 +148,9 @@ void sound_city_init(void)
         current_sound->total_views = 0;
         current_sound->filenames.current = 0;
         memset(current_sound->direction_views, 0, sizeof(current_sound->direction_views));
+        for (unsigned int i = 0; i < current_sound->filenames.total; i++) {
+            sound_device_preload_file(current_sound->filenames.list[i]);
+        }
     }
 }
 
@@ -249,6 +252,8 @@ static void play_sound(background_sound *sound, int direction)
 
 void sound_city_play(void)
 {
+    sound_device_process_preloads();
+
     time_millis now = time_get_millis();
     time_millis max_delay = 0;
     background_sound *sound_to_play = 0;
@@ -16,6 +16,17 @@ void sound_device_close(void);
 void sound_device_init_channels(void);
 int sound_device_is_file_playing_on_channel(const char *filename, sound_type type);
 
+/**
+ * Queues a sound file to be loaded into the sound cache ahead of being played
+ * @param filename Sound file
+ */
+void sound_device_preload_file(const char *filename);
+
+/**
+ * Loads the next queued sound file, should be called once per frame
+ */
+void sound_device_process_preloads(void);
+
 void sound_device_set_music_volume(int volume_pct);
 void sound_device_set_volume_for_type(sound_type type, int volume_pct);
 
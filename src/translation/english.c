@@ -877,6 +877,7 @@ static translation_string all_strings[] = {
     {TR_HOTKEY_SHOW_EMPIRE_MAP, "Show empire map"},
     {TR_TOGGLE_GRID, "Toggle grid"},
     {TR_WARNING_SCREENSHOT_SAVED, "Screenshot saved: "},
+    {TR_WARNING_SCREENSHOT_IN_PROGRESS, "Saving full city screenshot: "},
     {TR_OUT_OF_MONEY, "Out of money"},
     {TR_CITY_MESSAGE_TITLE_EMPERORS_WRATH, "Emperor's anger" },
     {TR_CITY_MESSAGE_TEXT_EMPERORS_WRATH, "You have fallen from Caesar's grace and so he has ordered your arrest. Unless you restore your favor with the emperor, his elite legionaries will soon invade your city!" },
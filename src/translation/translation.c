@@ -9,11 +9,21 @@
 #define BUFFER_SIZE 100000
 
 static struct {
-    uint8_t *strings[TRANSLATION_MAX_KEY];
+    const uint8_t *strings[TRANSLATION_MAX_KEY];
     uint8_t buffer[BUFFER_SIZE];
     int buf_index;
 } data;
 
+static int is_ascii(const char *string)
+{
+    for (; *string; string++) {
+        if (*string & 0x80) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
 static void set_strings(const translation_string *strings, int num_strings, int is_default)
 {
     for (int i = 0; i < num_strings; i++) {
@@ -24,6 +34,11 @@ static void set_strings(const translation_string *strings, int num_strings, int
         if (is_default) {
             log_info("Translation key not found:", string->string, string->key);
         }
+        if (is_ascii(string->string)) {
+            // ASCII is the same in every internal encoding, so the string can be used as it is
+            data.strings[string->key] = (const uint8_t *) string->string;
+            continue;
+        }
         int length_left = BUFFER_SIZE - data.buf_index;
         encoding_from_utf8(string->string, &data.buffer[data.buf_index], length_left);
         data.strings[string->key] = &data.buffer[data.buf_index];
@@ -872,6 +872,7 @@ typedef enum {
     TR_HOTKEY_SHOW_EMPIRE_MAP,
     TR_TOGGLE_GRID,
     TR_WARNING_SCREENSHOT_SAVED,
+    TR_WARNING_SCREENSHOT_IN_PROGRESS,
     TR_OUT_OF_MONEY,
     TR_CITY_MESSAGE_TITLE_EMPERORS_WRATH,
     TR_CITY_MESSAGE_TEXT_EMPERORS_WRATH,
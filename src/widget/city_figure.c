@@ -24,11 +24,11 @@ static color_t get_highlight_mask(int highlight_mask)
 static void draw_figure_with_cart(const figure *f, int x, int y, color_t color_mask, float scale)
 {
     if (f->y_offset_cart >= 0) {
-        image_draw(f->image_id, x, y, color_mask, scale);
+        image_draw(figure_image_get(f), x, y, color_mask, scale);
         image_draw(f->cart_image_id, x + f->x_offset_cart, y + f->y_offset_cart, color_mask, scale);
     } else {
         image_draw(f->cart_image_id, x + f->x_offset_cart, y + f->y_offset_cart, color_mask, scale);
-        image_draw(f->image_id, x, y, color_mask, scale);
+        image_draw(figure_image_get(f), x, y, color_mask, scale);
     }
 }
 
@@ -119,7 +119,7 @@ static void draw_fort_standard(const figure *f, int x, int y, float scale)
 {
     if (!formation_get(f->formation_id)->in_distant_battle) {
         // base
-        image_draw(f->image_id, x, y, COLOR_MASK_NONE, scale);
+        image_draw(figure_image_get(f), x, y, COLOR_MASK_NONE, scale);
         // flag
         int flag_height = image_get(f->cart_image_id)->height;
         image_draw(f->cart_image_id, x, y - flag_height, COLOR_MASK_NONE, scale);
@@ -132,7 +132,7 @@ static void draw_fort_standard(const figure *f, int x, int y, float scale)
 static void draw_map_flag(const figure *f, int x, int y, float scale)
 {
     // base
-    image_draw(f->image_id, x, y, COLOR_MASK_NONE, scale);
+    image_draw(figure_image_get(f), x, y, COLOR_MASK_NONE, scale);
     // flag
     image_draw(f->cart_image_id, x, y - image_get(f->cart_image_id)->height, COLOR_MASK_NONE, scale);
     // flag number
@@ -245,7 +245,8 @@ static void adjust_pixel_offset(const figure *f, int *pixel_x, int *pixel_y)
     x_offset += 29;
     y_offset += 15;
 
-    if (f->image_id >= 10000) {
+    unsigned int image_id = figure_image_get(f);
+    if (image_id >= 10000) {
         // TODO
         // Ugly hack, remove
         // Draws new walkers at their proper spots
@@ -254,7 +255,7 @@ static void adjust_pixel_offset(const figure *f, int *pixel_x, int *pixel_y)
     }
 
 
-    const image *img = f->is_enemy_image ? image_get_enemy(f->image_id) : image_get(f->image_id);
+    const image *img = f->is_enemy_image ? image_get_enemy(image_id) : image_get(image_id);
     *pixel_x += x_offset - (img->animation ? img->animation->sprite_offset_x : 0);
     *pixel_y += y_offset - (img->animation ? img->animation->sprite_offset_y : 0);
 }
@@ -285,15 +286,15 @@ static void draw_figure(const figure *f, int x, int y, float scale, int highligh
                 draw_map_flag(f, x, y, scale);
                 break;
             default:
-                image_draw(f->image_id, x, y, color_mask, scale);
+                image_draw(figure_image_get(f), x, y, color_mask, scale);
                 break;
         }
     } else {
         if (f->is_enemy_image) {
-            image_draw_enemy(f->image_id, x, y, scale);
+            image_draw_enemy(figure_image_get(f), x, y, scale);
         } else {
 
-            image_draw(f->image_id, x, y, color_mask, scale);
+            image_draw(figure_image_get(f), x, y, color_mask, scale);
         }
     }
 }
@@ -13,6 +13,7 @@
 #include "core/log.h"
 #include "figure/roamer_preview.h"
 #include "game/resource.h"
+#include "game/time.h"
 #include "game/state.h"
 #include "graphics/graphics.h"
 #include "graphics/image.h"
@@ -43,6 +44,18 @@ static const city_overlay *overlay = 0;
 static float scale = SCALE_NONE;
 static unsigned int city_roamer_preview_selected_building_id = ((unsigned int) -1); //NO_POSITION default
 
+// Column heights only change when the simulation runs or the city is changed,
+// so they are stored per tile once calculated and reused until then
+static struct {
+    grid_u8 is_known;
+    grid_i16 height;
+    int is_valid;
+    int overlay_type;
+    int tick;
+    int total_days;
+    int buildings_revision;
+} columns;
+
 #define SELECTED_BUILDING_COLOR_MASK COLOR_MASK_SKY_BLUE
 #define OFFSET(x,y) (x + GRID_SIZE * y)
 
@@ -152,6 +165,34 @@ static int select_city_overlay(void)
 void city_with_overlay_update(void)
 {
     select_city_overlay();
+    columns.is_valid = 0;
+}
+
+static void update_columns(void)
+{
+    int total_days = game_time_total_months() * 16 + game_time_day();
+    if (columns.is_valid && columns.overlay_type == overlay->type && columns.tick == game_time_tick() &&
+        columns.total_days == total_days && columns.buildings_revision == building_type_lists_revision()) {
+        return;
+    }
+    map_grid_clear_u8(columns.is_known.items);
+    columns.is_valid = 1;
+    columns.overlay_type = overlay->type;
+    columns.tick = game_time_tick();
+    columns.total_days = total_days;
+    columns.buildings_revision = building_type_lists_revision();
+}
+
+static int get_column_height(int grid_offset, const building *b)
+{
+    if (!columns.is_valid) {
+        return overlay->get_column_height(b);
+    }
+    if (!columns.is_known.items[grid_offset]) {
+        columns.is_known.items[grid_offset] = 1;
+        columns.height.items[grid_offset] = overlay->get_column_height(b);
+    }
+    return columns.height.items[grid_offset];
 }
 
 static color_t get_building_color_mask(const building *b)
@@ -667,7 +708,7 @@ void city_with_overlay_draw_building_top(int x, int y, int grid_offset)
     if (overlay->show_building(b)) {
         draw_building_top(grid_offset, b, x, y);
     } else {
-        int column_height = overlay->get_column_height(b);
+        int column_height = get_column_height(grid_offset, b);
         if (column_height != NO_COLUMN) {
             int draw = 1;
             if (building_is_farm(b->type)) {
@@ -847,6 +888,7 @@ void city_with_overlay_draw(const map_tile *tile, unsigned int roamer_preview_bu
         return;
     }
 
+    update_columns();
     scale = city_view_get_scale() / 100.0f;
     city_roamer_preview_selected_building_id = roamer_preview_building_id;
     int x, y, width, height;
@@ -5,7 +5,8 @@
 #include "map/point.h"
 
 /**
- * Update the internal state after changing overlay
+ * Update the internal state after changing overlay or when the city may have changed
+ * outside the simulation, so the overlay values are recalculated on the next draw
  */
 void city_with_overlay_update(void);
 
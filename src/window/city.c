@@ -54,6 +54,7 @@ static int mothball_warning_id;
 
 static void draw_background(void)
 {
+    city_with_overlay_update();
     if (window_is(WINDOW_CITY)) {
         widget_city_setup_routing_preview();
     }
@@ -63,6 +64,7 @@ static void draw_background(void)
 
 static void draw_background_military(void)
 {
+    city_with_overlay_update();
     if (config_get(CONFIG_UI_SHOW_MILITARY_SIDEBAR)) {
         widget_sidebar_military_draw_background();
     } else {
@@ -219,6 +221,7 @@ static void draw_speedrun_info(void)
 
 static void draw_foreground(void)
 {
+    figure_roamer_preview_process_pending();
     widget_top_menu_draw(0);
     window_city_draw();
     widget_sidebar_city_draw_foreground();